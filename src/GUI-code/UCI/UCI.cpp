@@ -29,6 +29,19 @@ constexpr auto QUIT = "quit";
 constexpr auto QUIT_SIZE = 4;
 constexpr auto UCI = "uci";
 constexpr auto UCI_SIZE = 3;
+constexpr auto SET_OPTION = "setoption";
+constexpr auto SET_OPTION_SIZE = 9;
+constexpr auto BENCH = "bench";
+constexpr auto BENCH_SIZE = 5;
+constexpr auto EVAL_BENCH = "evalbench";
+constexpr auto EVAL_BENCH_SIZE = 9;
+constexpr auto ATTACK_BENCH = "attackbench";
+constexpr auto ATTACK_BENCH_SIZE = 11;
+constexpr auto PERFT = "perft";
+constexpr auto PERFT_SIZE = 5;
+constexpr auto STARTUP = "startup";
+constexpr auto STARTUP_SIZE = 7;
+constexpr auto NANOSECONDS_PER_MICROSECOND = 1000ll;
 
 void UCI_Link::UCI_loop()
 {
@@ -53,6 +66,8 @@ void UCI_Link::UCI_loop()
         //Parse GUI is ready
         if (strncmp(input, IS_READY, IS_READY_SIZE) == 0)
         {
+            //Lines still queued for the writer thread must come before readyok
+            UCIOutput::flush();
             printf(READY_OK);
             continue;
         }
@@ -65,9 +80,48 @@ void UCI_Link::UCI_loop()
         //Parse GUI ucinewgame command
         if (strncmp(input, UCI_NEW_GAME, UCI_NEW_GAME_SIZE) == 0)
         {
+            //The only place where everything learned by the search is forgotten
+            NegaMax::clear_search_tables();
             parse_position(START_POS);
             continue;
         }
+        //Parse GUI setoption command
+        if (strncmp(input, SET_OPTION, SET_OPTION_SIZE) == 0)
+        {
+            parse_option(input);
+            continue;
+        }
+        //Parse bench command, not part of UCI
+        if (strncmp(input, BENCH, BENCH_SIZE) == 0)
+        {
+            parse_bench(input);
+            continue;
+        }
+        //Parse batch evaluation benchmark, not part of UCI
+        if (strncmp(input, EVAL_BENCH, EVAL_BENCH_SIZE) == 0)
+        {
+            parse_eval_bench(input);
+            continue;
+        }
+        //Parse slider attack benchmark, not part of UCI
+        if (strncmp(input, ATTACK_BENCH, ATTACK_BENCH_SIZE) == 0)
+        {
+            parse_attack_bench(input);
+            continue;
+        }
+        //Parse move generation benchmark, not part of UCI
+        if (strncmp(input, PERFT, PERFT_SIZE) == 0)
+        {
+            parse_perft(input);
+            continue;
+        }
+        //Report startup time, not part of UCI
+        if (strncmp(input, STARTUP, STARTUP_SIZE) == 0)
+        {
+            UCIOutput::send("startup time_us " + std::to_string(startup_time_ns_ / NANOSECONDS_PER_MICROSECOND));
+            UCIOutput::flush();
+            continue;
+        }
         //Parse GUI go command
         if (strncmp(input, GO_COMMAND, GO_COMMAND_SIZE) == 0)
         {
@@ -97,7 +151,10 @@ constexpr auto MINIMUM_PROMOTION_STRING_LENGTH = 5;
 const auto FAIL_PARSE = Move{};
 constexpr auto NO_PIECE = 0;
 
-bool isPromotion(int promotion_piece);
+constexpr auto BLACK_PIECE_OFFSET = 6;
+
+int parsePromotion(char promotion_char, int side_to_move);
+bool isSquareString(char file, char rank);
 
 //Recieves and input such as "a7a8q" or "b4b2"
 Move UCI_Link::parse_move(std::string move_string)
@@ -105,46 +162,25 @@ Move UCI_Link::parse_move(std::string move_string)
     //Check string is correct size
     if (move_string.size() < MINIMUM_MOVE_STRING_LENGTH)
         return FAIL_PARSE;
-    //Init Movelist from current Linker Boardstate
-    auto move_list = MoveList{};
-    board_state_->generate_moves(move_list);
+    if (!isSquareString(move_string[0], move_string[1]) || !isSquareString(move_string[2], move_string[3]))
+        return FAIL_PARSE;
+    //Decode the squares directly rather than generating every move
     int start_square = (move_string[0] - ALPHABET_SHIFTER) +
                        (NUMBER_OF_ROWS - (move_string[1] - NUMERIC_SHIFTER)) * NUMBER_OF_ROWS;
     int target_square = (move_string[2] - ALPHABET_SHIFTER) +
                         (NUMBER_OF_ROWS - (move_string[3] - NUMERIC_SHIFTER)) * NUMBER_OF_ROWS;
-    for (auto iCount = 0; iCount < move_list.get_num_moves(); iCount++)
+    int promotion_piece = NO_PIECE;
+    if (move_string.size() >= MINIMUM_PROMOTION_STRING_LENGTH)
     {
-        auto move = move_list.get_move(iCount);
-        if ((start_square == move.get_move_source_square()) &&
-            (target_square == move.get_move_target_square()))
-        {
-            auto promotion_piece = move.get_move_promotion_type();
-            if (isPromotion(promotion_piece))
-            {
-                if (move_string.size() < MINIMUM_PROMOTION_STRING_LENGTH)
-                {
-                    return FAIL_PARSE;
-                }
-                //Promoted to queen
-                if ((promotion_piece == Q || promotion_piece == q) && move_string[4] == 'q')
-                    return move;
-                //Promoted to rook
-                else if ((promotion_piece == R || promotion_piece == r) && move_string[4] == 'r')
-                    return move;
-                //Promoted to bishop
-                else if ((promotion_piece == B || promotion_piece == b) && move_string[4] == 'b')
-                    return move;
-                //Promoted to knight
-                else if ((promotion_piece == N || promotion_piece == n) && move_string[4] == 'n')
-                    return move;
-                continue;
-            }
-            //Move is legal non-promotion
-            return move;
-        }
+        promotion_piece = parsePromotion(move_string[4], board_state_->get_side_to_move());
+        if (promotion_piece == NO_PIECE)
+            return FAIL_PARSE;
     }
-    //Move not found
-    return FAIL_PARSE;
+    //Fill in the flags from the current Linker Boardstate and reject impossible moves
+    auto move = board_state_->build_move(start_square, target_square, promotion_piece);
+    if (!board_state_->is_pseudo_legal(move))
+        return FAIL_PARSE;
+    return move;
 }
 
 constexpr auto INVALD_UCI_COMMAND = "INVALID UCI COMMAND!\n";
@@ -155,29 +191,64 @@ constexpr auto STARTPOS_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQk
 constexpr auto DELETE_INDEX_TO_FEN = 13;
 constexpr auto MINIMUM_FEN = 15;
 constexpr auto MOVES_STRING_SIZE = 6;
-constexpr auto NO_MOVE = -1;
 constexpr auto MOVES_STRING = "moves";
+constexpr auto WHITESPACE = " \t\r\n";
 
 void UCI_Link::parse_position(std::string command)
+{
+    //Split the command into the position it starts from and the moves played since
+    auto moves_index = command.find(MOVES_STRING);
+    auto position_base = command.substr(0, moves_index);
+    position_base.erase(position_base.find_last_not_of(WHITESPACE) + 1);
+    auto position_moves = std::vector<std::string>{};
+    if (moves_index != std::string::npos)
+    {
+        std::istringstream move_string_stream(command.substr(moves_index + MOVES_STRING_SIZE));
+        std::string move_string = "";
+        while (move_string_stream >> move_string)
+            position_moves.push_back(move_string);
+    }
+    //GUIs resend the whole game each move, so only play the moves not already on the board
+    auto extends_position = (position_base == position_base_) &&
+                            (position_moves.size() >= position_moves_.size()) &&
+                            std::equal(position_moves_.begin(), position_moves_.end(), position_moves.begin());
+    if (!extends_position)
+    {
+        if (!parse_position_base(position_base))
+            return;
+        position_base_ = position_base;
+        position_moves_.clear();
+    }
+    for (auto iCount = position_moves_.size(); iCount < position_moves.size(); iCount++)
+    {
+        auto move = parse_move(position_moves[iCount]);
+        if (move.is_no_move() || !board_state_->make_move(move, all_moves))
+            break;
+        position_moves_.push_back(position_moves[iCount]);
+    }
+    board_state_->print_board();
+}
+
+bool UCI_Link::parse_position_base(std::string command)
 {
     std::istringstream command_string_stream(command);
     std::string position_string = "";
     if (!command_string_stream)
     {
         std::cout << INVALD_UCI_COMMAND << std::endl;
-        return;
+        return false;
     }
     command_string_stream >> position_string;
     if (position_string != POSITION_STRING)
     {
         std::cout << INVALD_UCI_COMMAND << std::endl;
-        return;
+        return false;
     }
     std::string position_type = "";
     if (!command_string_stream)
     {
         std::cout << INVALD_UCI_COMMAND << std::endl;
-        return;
+        return false;
     }
     command_string_stream >> position_type;
     if (position_type == STARTPOS_STRING)
@@ -189,13 +260,13 @@ void UCI_Link::parse_position(std::string command)
         if (!command_string_stream)
         {
             std::cout << INVALD_UCI_COMMAND << std::endl;
-            return;
+            return false;
         }
         std::string fen_string = command_string_stream.str();
         if (fen_string.size() < MINIMUM_FEN)
         {
             std::cout << INVALD_UCI_COMMAND << std::endl;
-            return;
+            return false;
         }
         fen_string.erase(fen_string.begin(), fen_string.begin()+DELETE_INDEX_TO_FEN);
         board_state_->FEN_parse(fen_string);
@@ -203,29 +274,9 @@ void UCI_Link::parse_position(std::string command)
     else
     {
         std::cout << INVALD_UCI_COMMAND << std::endl;
-        return;
-    }
-    std::string fen_string = command_string_stream.str();
-    auto moves_index = fen_string.find(MOVES_STRING);
-    if (moves_index == NO_MOVE)
-    {
-        board_state_->print_board();
-        return;
-    }
-    fen_string.erase(fen_string.begin(), fen_string.begin()+moves_index+MOVES_STRING_SIZE);
-    std::istringstream move_string_stream(fen_string);
-    while (move_string_stream)
-    {
-        std::string move_string = "";
-        move_string_stream >> move_string;
-        auto move = parse_move(move_string);
-        if (move.is_no_move())
-        {
-            break;
-        }
-        board_state_->make_move(move, all_moves);
+        return false;
     }
-    board_state_->print_board();
+    return true;
 }
 
 constexpr auto NO_DEPTH = -1;
@@ -240,11 +291,19 @@ constexpr char* WTIME = "wtime";
 constexpr char* BTIME = "btime";
 constexpr char* MOVES_TO_GO = "movestogo";
 constexpr char* MOVE_TIME = "movetime";
+constexpr auto NODES_STRING = "nodes";
+constexpr auto SEARCH_MOVES = "searchmoves";
+constexpr auto SEARCH_MOVES_SIZE = 11;
 constexpr auto PLACEHOLDER_DEPTH = 5;
+constexpr long long NO_NODES = 0;
 
 void UCI_Link::parse_go(char* command)
 {
     auto depth = NO_DEPTH;
+    auto nodes = NO_NODES;
+    auto search_moves = MoveList{};
+    //Limits of the previous "go" command do not carry over
+    NegaMax::gameTimer.reset_time_control();
     //ADAPTED FOLLOWING UCI GO PARSING FROM CODE MONKEY KING
     //Initialize argument variable
     char *argument = NULL;
@@ -289,6 +348,25 @@ void UCI_Link::parse_go(char* command)
         // parse search depth
         depth = atoi(argument + 6);
 
+    //UCI "nodes" command
+    if ((argument = strstr(command,NODES_STRING)))
+        // parse hard node limit
+        nodes = atoll(argument + 6);
+
+    //UCI "searchmoves" command, the moves run to the next go keyword
+    if ((argument = strstr(command,SEARCH_MOVES)))
+    {
+        std::istringstream search_moves_stream(argument + SEARCH_MOVES_SIZE);
+        std::string move_string = "";
+        while (search_moves_stream >> move_string)
+        {
+            auto move = parse_move(move_string);
+            if (move.is_no_move())
+                break;
+            search_moves.add_move(move);
+        }
+    }
+
     //No move time available
     if(NegaMax::gameTimer.movetime != NO_TIME)
     {
@@ -317,92 +395,340 @@ void UCI_Link::parse_go(char* command)
     if(depth == NO_DEPTH) {
         depth = MAX_DEPTH;
     }
+    NegaMax::set_node_limit(nodes);
+    NegaMax::set_search_moves(search_moves);
     std::string best_move = Search::search_position(board_state_,depth,NegaMaxSearch);
-    //UCI_Link::print_search_info(NegaMaxSearch);
-    std::cout << "bestmove " << best_move << std::endl;
+    UCIOutput::send("bestmove " + best_move);
+    //The search is over, make sure the GUI has everything before the next command
+    UCIOutput::flush();
+}
+
+constexpr auto NAME_STRING = "name";
+constexpr auto VALUE_STRING = "value";
+constexpr auto HASH_OPTION = "Hash";
+constexpr auto CLEAR_HASH_OPTION = "Clear Hash";
+constexpr auto PAWN_HASH_OPTION = "Pawn Hash";
+constexpr auto EVAL_CACHE_OPTION = "Eval Cache";
+constexpr auto LAZY_MARGIN_OPTION = "Lazy Eval Margin";
+constexpr auto USE_NNUE_OPTION = "Use NNUE";
+constexpr auto EVAL_FILE_OPTION = "EvalFile";
+constexpr auto TRUE_STRING = "true";
+constexpr auto FALSE_STRING = "false";
+
+struct PruningOption
+{
+    const char* name;
+    int pruning_type;
+};
+
+//Check options so each pruning technique can be switched off for testing
+constexpr PruningOption pruning_options[] =
+{
+    {"Futility Pruning", futility_pruning},
+    {"Reverse Futility Pruning", reverse_futility_pruning},
+    {"Razoring", razoring},
+    {"Delta Pruning", delta_pruning}
+};
+
+//Recieves an input such as "setoption name Hash value 64"
+void UCI_Link::parse_option(std::string command)
+{
+    std::istringstream command_string_stream(command);
+    std::string token = "";
+    command_string_stream >> token;
+    command_string_stream >> token;
+    if (token != NAME_STRING)
+    {
+        std::cout << INVALD_UCI_COMMAND << std::endl;
+        return;
+    }
+    //Option names may contain spaces and run up to "value"
+    std::string name = "";
+    std::string value = "";
+    while ((command_string_stream >> token) && (token != VALUE_STRING))
+        name += (name.empty() ? "" : " ") + token;
+    command_string_stream >> value;
+    if (name == HASH_OPTION && !value.empty())
+        TranspositionTable::resize(std::stoi(value));
+    else if (name == CLEAR_HASH_OPTION)
+        TranspositionTable::clear();
+    else if (name == PAWN_HASH_OPTION && !value.empty())
+        PawnTable::resize(std::stoi(value));
+    else if (name == EVAL_CACHE_OPTION && !value.empty())
+        EvalCache::resize(std::stoi(value));
+    else if (name == LAZY_MARGIN_OPTION && !value.empty())
+        BasicEval::set_lazy_margin(std::stoi(value));
+    else if (name == USE_NNUE_OPTION)
+        set_network_evaluation(value == TRUE_STRING);
+    else if (name == EVAL_FILE_OPTION && !value.empty())
+    {
+        eval_file_ = value;
+        if (NNUE::is_enabled())
+            set_network_evaluation(true);
+    }
+    for (auto &option : pruning_options)
+    {
+        if (name == option.name)
+            NegaMax::set_pruning(option.pruning_type, value == TRUE_STRING);
+    }
+}
+
+//Falls back to the classical evaluation when the weights cannot be loaded
+void UCI_Link::set_network_evaluation(bool enabled)
+{
+    if (enabled && !NNUE::load(eval_file_))
+    {
+        UCIOutput::send("info string could not load " + eval_file_ + ", using the classical evaluation");
+        UCIOutput::flush();
+    }
+    NNUE::set_enabled(enabled);
+    //Piece changes are only recorded while the network is enabled
+    board_state_->reset_accumulators();
+    //Cached scores came from the other evaluation
+    EvalCache::clear();
 }
 
 void UCI_Link::set_board_state(const ptr_board board_state)
 {
     board_state_ = board_state;
+    //The cached move history belongs to the previous board
+    position_base_.clear();
+    position_moves_.clear();
 }
 
 void UCI_Link::print_UCI_ID_Info()
 {
     printf("id name OmegaChess\n");
     printf("id author Keon Roohani\n");
+    printf("option name Hash type spin default %d min %d max %d\n", TranspositionTable::DEFAULT_SIZE_MB,
+           TranspositionTable::MINIMUM_SIZE_MB, TranspositionTable::MAXIMUM_SIZE_MB);
+    printf("option name Clear Hash type button\n");
+    printf("option name Pawn Hash type spin default %d min %d max %d\n", PawnTable::DEFAULT_SIZE_MB,
+           PawnTable::MINIMUM_SIZE_MB, PawnTable::MAXIMUM_SIZE_MB);
+    printf("option name Eval Cache type spin default %d min %d max %d\n", EvalCache::DEFAULT_SIZE_MB,
+           EvalCache::MINIMUM_SIZE_MB, EvalCache::MAXIMUM_SIZE_MB);
+    printf("option name %s type spin default %d min %d max %d\n", LAZY_MARGIN_OPTION, BasicEval::DEFAULT_LAZY_MARGIN,
+           BasicEval::MINIMUM_LAZY_MARGIN, BasicEval::MAXIMUM_LAZY_MARGIN);
+    printf("option name %s type check default %s\n", USE_NNUE_OPTION, FALSE_STRING);
+    printf("option name %s type string default %s\n", EVAL_FILE_OPTION, NNUE::DEFAULT_FILE);
+    for (auto &option : pruning_options)
+        printf("option name %s type check default %s\n", option.name,
+               NegaMax::get_pruning(option.pruning_type) ? TRUE_STRING : FALSE_STRING);
     printf("uciok\n");
 }
 
 int UCI_Link::score_{0};
-int UCI_Link::nodes_{0};
+long long UCI_Link::nodes_{0};
 int UCI_Link::depth_{0};
+int UCI_Link::seldepth_{0};
+long long UCI_Link::time_{0};
 
-void UCI_Link::set_search_info(int score, int depth,int nodes)
+void UCI_Link::set_search_info(int score, int depth, int seldepth, long long nodes, long long time)
 {
     score_ = score;
     depth_ = depth;
+    seldepth_ = seldepth;
     nodes_ = nodes;
+    time_ = time;
 }
 
 void UCI_Link::print_search_info(int search_type)
 {
-    printf("info ");
-    print_score_info(score_);
-    print_depth_info(depth_);
-    print_node_info(nodes_);
+    std::string info = "info ";
+    info += get_depth_info(depth_, seldepth_);
+    info += get_score_info(score_);
+    info += get_node_info(nodes_, time_);
     if (search_type == NegaMaxSearch)
-        print_PV_info();
-    printf("\n");
+        info += get_PV_info();
+    UCIOutput::send(info);
 }
 
-void UCI_Link::print_score_info(int score)
+//Sent periodically during long iterations
+void UCI_Link::print_progress_info(int depth, int seldepth, long long nodes, long long time,
+                                   Move current_move, int current_move_number)
 {
-    printf("score cp %d ", score);
+    std::string info = "info ";
+    info += get_depth_info(depth, seldepth);
+    info += get_node_info(nodes, time);
+    if (!current_move.is_no_move())
+    {
+        info += "currmove " + current_move.get_move_UCI() +
+                " currmovenumber " + std::to_string(current_move_number);
+    }
+    UCIOutput::send(info);
 }
 
-void UCI_Link::print_depth_info(int depth)
+std::string UCI_Link::get_score_info(int score)
 {
-    printf("depth %d ", depth);
+    return "score cp " + std::to_string(score) + " ";
 }
 
-void UCI_Link::print_node_info(int nodes)
+std::string UCI_Link::get_depth_info(int depth, int seldepth)
 {
-    printf("nodes %ld ", nodes);
+    return "depth " + std::to_string(depth) + " seldepth " + std::to_string(seldepth) + " ";
 }
 
-void UCI_Link::print_PV_info()
+constexpr auto MILLISECONDS_PER_SECOND = 1000ll;
+constexpr auto MINIMUM_TIME = 1ll;
+
+std::string UCI_Link::get_node_info(long long nodes, long long time)
 {
-    printf("pv ");
+    auto nps = nodes * MILLISECONDS_PER_SECOND / std::max(time, MINIMUM_TIME);
+    return "nodes " + std::to_string(nodes) + " nps " + std::to_string(nps) +
+           " time " + std::to_string(time) + " hashfull " + std::to_string(TranspositionTable::hashfull()) + " ";
+}
+
+constexpr auto BENCH_DEPTH = 7;
+constexpr auto PERMILL = 1000ll;
+constexpr auto MINIMUM_PROBES = 1ll;
+//Recieves an input such as "bench" or "bench 8", searches every bench position to the depth
+void UCI_Link::parse_bench(std::string command)
+{
+    std::istringstream command_string_stream(command);
+    std::string token = "";
+    auto depth = BENCH_DEPTH;
+    command_string_stream >> token;
+    if ((command_string_stream >> token) && (std::atoi(token.c_str()) > 0))
+        depth = std::atoi(token.c_str());
+    auto no_search_moves = MoveList{};
+    auto total_nodes = 0ll;
+    auto start_time = UCITimer::get_time_ms();
+    PawnTable::reset_counters();
+    EvalCache::reset_counters();
+    BasicEval::reset_lazy_counters();
+    for (auto fen : Bench::positions)
+    {
+        //Every position starts from empty tables so the count is reproducible
+        NegaMax::clear_search_tables();
+        NegaMax::gameTimer.reset_time_control();
+        NegaMax::set_node_limit(NO_NODES);
+        NegaMax::set_search_moves(no_search_moves);
+        board_state_->FEN_parse(fen);
+        Search::search_position(board_state_, depth, NegaMaxSearch);
+        total_nodes += NegaMax::get_nodes();
+    }
+    //The board no longer matches the last "position" command
+    position_base_.clear();
+    position_moves_.clear();
+    auto time = std::max(UCITimer::get_time_ms() - start_time, MINIMUM_TIME);
+    UCIOutput::send("bench depth " + std::to_string(depth) + " nodes " + std::to_string(total_nodes) +
+                    " time " + std::to_string(time) +
+                    " nps " + std::to_string(total_nodes * MILLISECONDS_PER_SECOND / time) +
+                    " pawnhits " + std::to_string(PawnTable::get_hits() * PERMILL /
+                                                  std::max(PawnTable::get_probes(), MINIMUM_PROBES)) +
+                    " evalhits " + std::to_string(EvalCache::get_hits() * PERMILL /
+                                                  std::max(EvalCache::get_probes(), MINIMUM_PROBES)) +
+                    " lazyskips " + std::to_string(BasicEval::get_lazy_exits() * PERMILL /
+                                                   std::max(BasicEval::get_lazy_exits() +
+                                                            BasicEval::get_full_evaluations(), MINIMUM_PROBES)));
+    UCIOutput::flush();
+}
+
+constexpr auto EVAL_BENCH_POSITIONS = 1000000;
+
+//Recieves an input such as "evalbench" or "evalbench 500000", evaluates positions from random
+//playouts of the bench positions with the scalar, vectorised and threaded batch paths
+void UCI_Link::parse_eval_bench(std::string command)
+{
+    std::istringstream command_string_stream(command);
+    std::string token = "";
+    auto count = EVAL_BENCH_POSITIONS;
+    command_string_stream >> token;
+    if ((command_string_stream >> token) && (std::atoi(token.c_str()) > 0))
+        count = std::atoi(token.c_str());
+    auto result = Bench::run_eval_bench(count);
+    UCIOutput::send("evalbench positions " + std::to_string(count) + " scalar " + std::to_string(result.scalar_rate) +
+                    " simd " + std::to_string(result.simd_rate) + " threads " + std::to_string(result.threads) +
+                    " threaded " + std::to_string(result.threaded_rate) +
+                    " mismatches " + std::to_string(result.mismatches));
+    UCIOutput::flush();
+}
+
+constexpr auto ATTACK_BENCH_POSITIONS = 100000;
+
+//Recieves an input such as "attackbench" or "attackbench 50000", finds the attacks and mobility
+//of all rooks, bishops and queens of each side in playout positions, once by summing magic
+//lookups per piece and once with the scalar and vectorised occluded fills
+void UCI_Link::parse_attack_bench(std::string command)
+{
+    std::istringstream command_string_stream(command);
+    std::string token = "";
+    auto count = ATTACK_BENCH_POSITIONS;
+    command_string_stream >> token;
+    if ((command_string_stream >> token) && (std::atoi(token.c_str()) > 0))
+        count = std::atoi(token.c_str());
+    auto result = Bench::run_attack_bench(count);
+    UCIOutput::send("attackbench sides " + std::to_string(result.sides) + " magic " + std::to_string(result.magic_rate) +
+                    " fill " + std::to_string(result.fill_rate) + " simdfill " + std::to_string(result.simd_fill_rate) +
+                    " mismatches " + std::to_string(result.mismatches));
+    UCIOutput::flush();
+}
+
+constexpr auto PERFT_DEPTH = 4;
+
+//Recieves an input such as "perft" or "perft 5", counts the move tree of every bench position
+//to the depth to time move generation and make_move
+void UCI_Link::parse_perft(std::string command)
+{
+    std::istringstream command_string_stream(command);
+    std::string token = "";
+    auto depth = PERFT_DEPTH;
+    command_string_stream >> token;
+    if ((command_string_stream >> token) && (std::atoi(token.c_str()) > 0))
+        depth = std::atoi(token.c_str());
+    auto total_nodes = 0ll;
+    auto start_time = UCITimer::get_time_ms();
+    for (auto fen : Bench::positions)
+    {
+        board_state_->FEN_parse(fen);
+        total_nodes += board_state_->perft(depth);
+    }
+    //The board no longer matches the last "position" command
+    position_base_.clear();
+    position_moves_.clear();
+    auto time = std::max(UCITimer::get_time_ms() - start_time, MINIMUM_TIME);
+    UCIOutput::send("perft depth " + std::to_string(depth) + " nodes " + std::to_string(total_nodes) +
+                    " time " + std::to_string(time) +
+                    " nps " + std::to_string(total_nodes * MILLISECONDS_PER_SECOND / time));
+    UCIOutput::flush();
+}
+
+void UCI_Link::set_startup_time(long long time_ns)
+{
+    startup_time_ns_ = time_ns;
+}
+
+std::string UCI_Link::get_PV_info()
+{
+    std::string pv = "pv";
     for (int iCount = 0; iCount < NegaMax::PV_length[0]; iCount++)
     {
-        NegaMax::PV_table[0][iCount].print_move_UCI();
+        pv += " " + NegaMax::PV_table[0][iCount].get_move_UCI();
     }
+    return pv;
 }
 
 
-bool isPromotion(int promotion_piece)
+int parsePromotion(char promotion_char, int side_to_move)
 {
-    switch (promotion_piece)
+    auto color_offset = (side_to_move == white) ? 0 : BLACK_PIECE_OFFSET;
+    switch (promotion_char)
     {
-    case (Q):
-        return true;
-    case (q):
-        return true;
-    case (R):
-        return true;
-    case (r):
-        return true;
-    case (B):
-        return true;
-    case (b):
-        return true;
-    case (N):
-        return true;
-    case (n):
-        return true;
+    case ('q'):
+        return Q + color_offset;
+    case ('r'):
+        return R + color_offset;
+    case ('b'):
+        return B + color_offset;
+    case ('n'):
+        return N + color_offset;
     default:
-        return false;
+        return NO_PIECE;
     }
-    return false;
+    return NO_PIECE;
+}
+
+bool isSquareString(char file, char rank)
+{
+    return (file >= 'a') && (file <= 'h') && (rank >= '1') && (rank <= '8');
 }
@@ -4,10 +4,17 @@
 #include <string>
 #include <memory>
 #include <sstream>
+#include <vector>
+#include <algorithm>
 
 #include "../../engine-code/BoardState.h"
 #include "../../engine-code/Evaluation/BasicEval.h"
+#include "../../engine-code/Evaluation/PawnTable.h"
+#include "../../engine-code/Evaluation/EvalCache.h"
+#include "../../engine-code/Evaluation/NNUE.h"
 #include "../../engine-code/Search/Search.h"
+#include "../../engine-code/Bench/Bench.h"
+#include "UCIOutput.h"
 
 /** \file UCI.h
     \brief Contains UCI implementation for GUI
@@ -24,19 +31,36 @@ public:
     Move parse_move(std::string move_string);
     void parse_position(std::string command);
     void parse_go(char* command);
+    void parse_option(std::string command);
+    void parse_bench(std::string command);
+    void parse_eval_bench(std::string command);
+    void parse_attack_bench(std::string command);
+    void parse_perft(std::string command);
+    //Time spent in main before the UCI loop starts, reported by the "startup" command
+    void set_startup_time(long long time_ns);
     void set_board_state(const ptr_board board_state);
-    static void set_search_info(int score, int depth,int nodes);
+    static void set_search_info(int score, int depth, int seldepth, long long nodes, long long time);
     static void print_search_info(int search_type);
+    static void print_progress_info(int depth, int seldepth, long long nodes, long long time,
+                                    Move current_move, int current_move_number);
 private:
-    static void print_score_info(int score);
-    static void print_depth_info(int depth);
-    static void print_node_info(int nodes);
-    static void print_PV_info();
+    static std::string get_score_info(int score);
+    static std::string get_depth_info(int depth, int seldepth);
+    static std::string get_node_info(long long nodes, long long time);
+    static std::string get_PV_info();
     void print_UCI_ID_Info();
+    bool parse_position_base(std::string command);
+    void set_network_evaluation(bool enabled);
     ptr_board board_state_;
+    std::string position_base_;
+    std::vector<std::string> position_moves_;
+    std::string eval_file_ = NNUE::DEFAULT_FILE;
+    long long startup_time_ns_ = 0;
     static int score_;
     static int depth_;
-    static int nodes_;
+    static int seldepth_;
+    static long long nodes_;
+    static long long time_;
 };
 
 #endif
@@ -0,0 +1,56 @@
+#include "UCIOutput.h"
+
+#include <cstdio>
+#include <thread>
+
+//Never destroyed as the detached writer may still be waiting on it at exit
+UCIOutput::WriterState& UCIOutput::get_state()
+{
+    static auto state = new WriterState{};
+    return *state;
+}
+
+void UCIOutput::send(const std::string &line)
+{
+    auto &state = get_state();
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (!state.writer_started)
+        {
+            state.writer_started = true;
+            //Lives for the whole process, flush() is used to wait on it
+            std::thread(writer_loop).detach();
+        }
+        state.lines.push_back(line);
+    }
+    state.lines_waiting.notify_one();
+}
+
+void UCIOutput::flush()
+{
+    auto &state = get_state();
+    std::unique_lock<std::mutex> lock(state.mutex);
+    state.lines_written.wait(lock, [&state] { return state.lines.empty() && !state.writing; });
+}
+
+void UCIOutput::writer_loop()
+{
+    auto &state = get_state();
+    std::unique_lock<std::mutex> lock(state.mutex);
+    while (true)
+    {
+        state.lines_waiting.wait(lock, [&state] { return !state.lines.empty(); });
+        auto line = std::move(state.lines.front());
+        state.lines.pop_front();
+        state.writing = true;
+        //Write without holding the lock so the search can keep queueing
+        lock.unlock();
+        fputs(line.c_str(), stdout);
+        fputc('\n', stdout);
+        fflush(stdout);
+        lock.lock();
+        state.writing = false;
+        if (state.lines.empty())
+            state.lines_written.notify_all();
+    }
+}
@@ -0,0 +1,35 @@
+#ifndef UCIOUTPUT_H
+#define UCIOUTPUT_H
+
+/** \file UCIOutput.h
+    \brief Contains asynchronous writer for UCI output
+ */
+
+#include <string>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+//Lines sent during a search are queued and written to stdout by a
+//separate thread so that a slow GUI pipe never stalls the search
+class UCIOutput
+{
+public:
+    static void send(const std::string &line);
+    //Blocks until every queued line has been written
+    static void flush();
+private:
+    struct WriterState
+    {
+        std::mutex mutex;
+        std::condition_variable lines_waiting;
+        std::condition_variable lines_written;
+        std::deque<std::string> lines;
+        bool writing = false;
+        bool writer_started = false;
+    };
+    static WriterState& get_state();
+    static void writer_loop();
+};
+
+#endif
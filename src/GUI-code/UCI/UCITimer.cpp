@@ -1,32 +1,44 @@
 #include "UCITimer.h"
 #include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <unistd.h>
 using namespace std;
 
+constexpr auto DEFAULT_MOVES_TO_GO = 30;
+constexpr auto NO_TIME = -1;
+constexpr auto NO_INCREMENT = 0;
+
 bool UCITimer::quit{false};
-int UCITimer::movestogo{30};
-int UCITimer::movetime{-1};
-int UCITimer::time{-1};
-int UCITimer::inc{0};
-int UCITimer::starttime{0};
-int UCITimer::stoptime{0};
+int UCITimer::movestogo{DEFAULT_MOVES_TO_GO};
+int UCITimer::movetime{NO_TIME};
+int UCITimer::time{NO_TIME};
+int UCITimer::inc{NO_INCREMENT};
+long long UCITimer::starttime{0};
+long long UCITimer::stoptime{0};
 int UCITimer::timeset{0};
 bool UCITimer::stopped{false};
+long long UCITimer::next_poll_nodes{0};
+long long UCITimer::last_poll_nodes{0};
+long long UCITimer::last_poll_time{0};
 
 /*
     NOTE THIS CODE IS TAKEN FROM CODE MONKEY KING
 */
 
-// get time in milliseconds
-int UCITimer::get_time_ms()
+// get monotonic time in milliseconds
+long long UCITimer::get_time_ms()
 {
-    #ifdef WIN64
-        return GetTickCount();
-    #else
-        struct timeval time_value;
-        gettimeofday(&time_value, NULL);
-        return time_value.tv_sec * 1000 + time_value.tv_usec / 1000;
-    #endif
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+           std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// get monotonic time in nanoseconds
+long long UCITimer::get_time_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch()).count();
 }
 
 int UCITimer::input_waiting()
@@ -122,8 +134,15 @@ void UCITimer::read_input()
     }
 }
 
+constexpr auto INITIAL_POLL_BUDGET = 1024ll;
+constexpr auto MINIMUM_POLL_BUDGET = 256ll;
+constexpr auto MAXIMUM_POLL_BUDGET = 1ll << 20;
+constexpr auto POLL_INTERVAL_NS = 5000000ll;
+constexpr auto NANOSECONDS_PER_MILLISECOND = 1000000ll;
+
 // a bridge function to interact between search and GUI input
-void UCITimer::communicate() {
+// only called once the node budget since the last poll is used up
+void UCITimer::communicate(long long nodes) {
 	// if time is up break here
     if(timeset == 1 && get_time_ms() > stoptime) {
 		// tell engine to stop calculating
@@ -132,6 +151,49 @@ void UCITimer::communicate() {
 
     // read GUI input
 	read_input();
+
+    // work out how many nodes can be searched before the clock is read again
+    calibrate_poll_budget(nodes);
+}
+
+// reset the node budget at the start of a search
+void UCITimer::start_polling(long long nodes) {
+    last_poll_nodes = nodes;
+    last_poll_time = get_time_ns();
+    next_poll_nodes = nodes + INITIAL_POLL_BUDGET;
+}
+
+// scale the node budget to the measured node rate so that the clock is read
+// about every POLL_INTERVAL_NS, and never later than the deadline
+void UCITimer::calibrate_poll_budget(long long nodes) {
+    auto now = get_time_ns();
+    auto elapsed = now - last_poll_time;
+    auto searched = nodes - last_poll_nodes;
+    auto budget = INITIAL_POLL_BUDGET;
+    if (elapsed > 0 && searched > 0)
+    {
+        auto interval = POLL_INTERVAL_NS;
+        if (timeset == 1)
+        {
+            auto remaining = stoptime * NANOSECONDS_PER_MILLISECOND - now;
+            if (remaining < interval)
+                interval = remaining;
+        }
+        budget = static_cast<long long>(static_cast<double>(searched) * interval / elapsed);
+    }
+    budget = std::clamp(budget, MINIMUM_POLL_BUDGET, MAXIMUM_POLL_BUDGET);
+    last_poll_nodes = nodes;
+    last_poll_time = now;
+    next_poll_nodes = nodes + budget;
+}
+
+// clear the limits of the previous "go" command
+void UCITimer::reset_time_control() {
+    movestogo = DEFAULT_MOVES_TO_GO;
+    movetime = NO_TIME;
+    time = NO_TIME;
+    inc = NO_INCREMENT;
+    timeset = 0;
 }
 
 bool UCITimer::get_stopped() {
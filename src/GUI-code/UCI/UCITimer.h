@@ -11,32 +11,42 @@
     #include <sys/time.h>
 #endif // WIN64
 
-//NOTE NOT YET TESTED ON LINUX OR MAC OS
+//Timing uses std::chrono::steady_clock so deadlines are not affected by
+//system clock adjustments and do not overflow on long running processes
 class UCITimer
 {
 public:
     //Public functions
-    static int get_time_ms();
+    static long long get_time_ms();
+    static long long get_time_ns();
     static int input_waiting();
     static void read_input();
-    static void communicate();
+    static void communicate(long long nodes);
+    static void start_polling(long long nodes);
+    static void reset_time_control();
     static bool get_stopped();
     static void set_stopped(bool is_stopped);
+    //Cheap check used by the search to decide if the clock must be read
+    static inline bool poll_due(long long nodes)
+    {
+        return nodes >= next_poll_nodes;
+    }
     static int movestogo;
     static int movetime;
     static int time;
     static int inc;
-    static int starttime;
-    static int stoptime;
+    static long long starttime;
+    static long long stoptime;
     static int timeset;
 private:
+    static void calibrate_poll_budget(long long nodes);
     //UCI Timing Private Variables 
     static bool quit;
     static bool stopped;
+    //Node count budget between clock reads, calibrated against the clock
+    static long long next_poll_nodes;
+    static long long last_poll_nodes;
+    static long long last_poll_time;
 };
 
 #endif  
-    
-    
-    
-    
\ No newline at end of file
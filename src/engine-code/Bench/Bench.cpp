@@ -0,0 +1,294 @@
+#include "Bench.h"
+
+#include <random>
+#include <thread>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "../Evaluation/BatchEval.h"
+#include "../../GUI-code/UCI/UCITimer.h"
+
+constexpr auto MILLISECONDS_PER_SECOND = 1000ll;
+constexpr auto MINIMUM_TIME = 1ll;
+constexpr auto PLAYOUT_PLIES = 60;
+constexpr auto PLAYOUT_SEED = 1u;
+constexpr auto EVAL_BENCH_PASSES = 10;
+
+void Bench::collect_playout_positions(int count, const std::function<void(std::shared_ptr<Boardstate>)> &collect)
+{
+    std::mt19937 generator(PLAYOUT_SEED);
+    auto board_state = std::make_shared<Boardstate>();
+    auto collected = 0;
+    while (collected < count)
+    {
+        board_state->FEN_parse(positions[generator() % std::size(positions)]);
+        for (auto ply = 0; (ply < PLAYOUT_PLIES) && (collected < count); ply++)
+        {
+            collect(board_state);
+            collected++;
+            MoveList move_list;
+            board_state->generate_moves(move_list);
+            if (move_list.get_num_moves() == 0)
+                break;
+            //Illegal picks leave the board unchanged and the next ply tries again
+            auto move = move_list.get_move(generator() % move_list.get_num_moves());
+            board_state->make_move(move, all_moves);
+        }
+    }
+}
+
+//Times one batch evaluation path over several passes, returns positions per second
+template <typename Evaluator>
+static long long time_batch(const std::vector<BatchEval::CompactPosition> &positions, std::vector<int> &scores,
+                            Evaluator evaluator)
+{
+    auto start_time = UCITimer::get_time_ms();
+    for (auto pass = 0; pass < EVAL_BENCH_PASSES; pass++)
+        evaluator(positions.data(), static_cast<int>(positions.size()), scores.data());
+    auto time = std::max(UCITimer::get_time_ms() - start_time, MINIMUM_TIME);
+    return static_cast<long long>(positions.size()) * EVAL_BENCH_PASSES * MILLISECONDS_PER_SECOND / time;
+}
+
+Bench::EvalBenchResult Bench::run_eval_bench(int count)
+{
+    std::vector<BatchEval::CompactPosition> positions;
+    positions.reserve(count);
+    collect_playout_positions(count, [&positions](std::shared_ptr<Boardstate> board_state)
+                              { positions.push_back(BatchEval::compact(board_state)); });
+    auto result = EvalBenchResult{};
+    result.threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<int> reference(count), scalar_scores(count), simd_scores(count), threaded_scores(count);
+    BatchEval::evaluate_scalar(positions.data(), count, reference.data());
+    result.scalar_rate = time_batch(positions, scalar_scores, BatchEval::evaluate_scalar);
+    result.simd_rate = time_batch(positions, simd_scores, [](auto data, auto size, auto scores)
+                                  { BatchEval::evaluate(data, size, scores); });
+    result.threaded_rate = time_batch(positions, threaded_scores, [&result](auto data, auto size, auto scores)
+                                      { BatchEval::evaluate(data, size, scores, result.threads); });
+    for (auto i = 0; i < count; i++)
+        result.mismatches += (simd_scores[i] != reference[i]) + (threaded_scores[i] != reference[i]);
+    return result;
+}
+
+constexpr auto ATTACK_BENCH_PASSES = 20;
+constexpr auto BLACK_PIECE_OFFSET = 6;
+constexpr int ORTHOGONAL_DIRECTIONS[] = {0, 1, 4, 5};
+constexpr int DIAGONAL_DIRECTIONS[] = {2, 3, 6, 7};
+
+//Sliding attacks of whole piece sets with Kogge-Stone occluded fills, one fill per
+//direction instead of one magic lookup per piece. The directions are stored as
+//  south, east, south-west, south-east  (towards h1, squares shifted up)
+//  north, west, north-east, north-west  (towards a8, squares shifted down)
+//the orthogonal set fills directions 0, 1, 4 and 5, the diagonal set the others.
+//Two pieces never reach the same square in the same direction, since the nearer one
+//blocks the other, so popcounts of the directions add up to the per-piece counts.
+constexpr int NUM_FILL_DIRECTIONS = 8;
+constexpr int FILL_SHIFTS[NUM_FILL_DIRECTIONS / 2] = {8, 1, 7, 9};
+constexpr bitboard FILL_NOT_A_FILE = 0xFEFEFEFEFEFEFEFEull;
+constexpr bitboard FILL_NOT_H_FILE = 0x7F7F7F7F7F7F7F7Full;
+constexpr bitboard FILL_ALL_FILES = ~0ull;
+//Squares a fill may enter after a shift, anything else wrapped around the board edge
+constexpr bitboard FILL_WRAP_MASKS[NUM_FILL_DIRECTIONS] = {
+    FILL_ALL_FILES, FILL_NOT_A_FILE, FILL_NOT_H_FILE, FILL_NOT_A_FILE,
+    FILL_ALL_FILES, FILL_NOT_H_FILE, FILL_NOT_A_FILE, FILL_NOT_H_FILE
+};
+constexpr int FIRST_DOWN_DIRECTION = NUM_FILL_DIRECTIONS / 2;
+
+static bitboard fill_up(bitboard generators, bitboard empty, int shift, bitboard wrap_mask)
+{
+    auto propagators = empty & wrap_mask;
+    generators |= propagators & (generators << shift);
+    propagators &= propagators << shift;
+    generators |= propagators & (generators << (2 * shift));
+    propagators &= propagators << (2 * shift);
+    generators |= propagators & (generators << (4 * shift));
+    return (generators << shift) & wrap_mask;
+}
+
+static bitboard fill_down(bitboard generators, bitboard empty, int shift, bitboard wrap_mask)
+{
+    auto propagators = empty & wrap_mask;
+    generators |= propagators & (generators >> shift);
+    propagators &= propagators >> shift;
+    generators |= propagators & (generators >> (2 * shift));
+    propagators &= propagators >> (2 * shift);
+    generators |= propagators & (generators >> (4 * shift));
+    return (generators >> shift) & wrap_mask;
+}
+
+//Scalar version, also the reference the vector version is checked against
+static void fill_slider_attacks_scalar(bitboard orthogonal, bitboard diagonal, bitboard empty,
+                                       bitboard (&attacks)[NUM_FILL_DIRECTIONS])
+{
+    for (auto direction = 0; direction < FIRST_DOWN_DIRECTION; direction++)
+    {
+        auto generators = (direction < 2) ? orthogonal : diagonal;
+        attacks[direction] = fill_up(generators, empty, FILL_SHIFTS[direction], FILL_WRAP_MASKS[direction]);
+        attacks[direction + FIRST_DOWN_DIRECTION] =
+            fill_down(generators, empty, FILL_SHIFTS[direction], FILL_WRAP_MASKS[direction + FIRST_DOWN_DIRECTION]);
+    }
+}
+
+//Four directions per AVX2 register, one lane each, with a scalar fallback
+static void fill_slider_attacks(bitboard orthogonal, bitboard diagonal, bitboard empty,
+                                bitboard (&attacks)[NUM_FILL_DIRECTIONS])
+{
+#if defined(__AVX2__)
+    const auto shift = _mm256_setr_epi64x(FILL_SHIFTS[0], FILL_SHIFTS[1], FILL_SHIFTS[2], FILL_SHIFTS[3]);
+    const auto shift_2 = _mm256_add_epi64(shift, shift);
+    const auto shift_4 = _mm256_add_epi64(shift_2, shift_2);
+    const auto up_wrap = _mm256_setr_epi64x(FILL_WRAP_MASKS[0], FILL_WRAP_MASKS[1],
+                                            FILL_WRAP_MASKS[2], FILL_WRAP_MASKS[3]);
+    const auto down_wrap = _mm256_setr_epi64x(FILL_WRAP_MASKS[4], FILL_WRAP_MASKS[5],
+                                              FILL_WRAP_MASKS[6], FILL_WRAP_MASKS[7]);
+    const auto start = _mm256_setr_epi64x(orthogonal, orthogonal, diagonal, diagonal);
+    const auto empty_squares = _mm256_set1_epi64x(empty);
+    //Up fills
+    auto generators = start;
+    auto propagators = _mm256_and_si256(empty_squares, up_wrap);
+    generators = _mm256_or_si256(generators, _mm256_and_si256(propagators, _mm256_sllv_epi64(generators, shift)));
+    propagators = _mm256_and_si256(propagators, _mm256_sllv_epi64(propagators, shift));
+    generators = _mm256_or_si256(generators, _mm256_and_si256(propagators, _mm256_sllv_epi64(generators, shift_2)));
+    propagators = _mm256_and_si256(propagators, _mm256_sllv_epi64(propagators, shift_2));
+    generators = _mm256_or_si256(generators, _mm256_and_si256(propagators, _mm256_sllv_epi64(generators, shift_4)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(attacks),
+                        _mm256_and_si256(_mm256_sllv_epi64(generators, shift), up_wrap));
+    //Down fills
+    generators = start;
+    propagators = _mm256_and_si256(empty_squares, down_wrap);
+    generators = _mm256_or_si256(generators, _mm256_and_si256(propagators, _mm256_srlv_epi64(generators, shift)));
+    propagators = _mm256_and_si256(propagators, _mm256_srlv_epi64(propagators, shift));
+    generators = _mm256_or_si256(generators, _mm256_and_si256(propagators, _mm256_srlv_epi64(generators, shift_2)));
+    propagators = _mm256_and_si256(propagators, _mm256_srlv_epi64(propagators, shift_2));
+    generators = _mm256_or_si256(generators, _mm256_and_si256(propagators, _mm256_srlv_epi64(generators, shift_4)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(attacks + FIRST_DOWN_DIRECTION),
+                        _mm256_and_si256(_mm256_srlv_epi64(generators, shift), down_wrap));
+#else
+    fill_slider_attacks_scalar(orthogonal, diagonal, empty, attacks);
+#endif
+}
+
+//The sliders of one side with the squares their mobility counts
+class SliderSet
+{
+public:
+    bitboard rooks;
+    bitboard bishops;
+    bitboard queens;
+    bitboard occupancy;
+    bitboard mobility_area;
+};
+
+//Attacks of all rooks, bishops and queens of a side with their summed mobility
+class SliderAttacks
+{
+public:
+    bitboard rooks = 0;
+    bitboard bishops = 0;
+    bitboard queens = 0;
+    int mobility = 0;
+    bool operator!=(const SliderAttacks &other) const
+    {
+        return (rooks != other.rooks) || (bishops != other.bishops) || (queens != other.queens) ||
+               (mobility != other.mobility);
+    }
+};
+
+static SliderAttacks magic_slider_attacks(const SliderSet &set)
+{
+    auto result = SliderAttacks{};
+    for (auto bitmap = set.rooks; bitmap; bitmap &= bitmap - 1)
+    {
+        auto attacks = RookAttacks::get_rook_attacks(Bitboard::get_lsb_index(bitmap), set.occupancy);
+        result.rooks |= attacks;
+        result.mobility += Bitboard::count_bits(attacks & set.mobility_area);
+    }
+    for (auto bitmap = set.bishops; bitmap; bitmap &= bitmap - 1)
+    {
+        auto attacks = BishopAttacks::get_bishop_attacks(Bitboard::get_lsb_index(bitmap), set.occupancy);
+        result.bishops |= attacks;
+        result.mobility += Bitboard::count_bits(attacks & set.mobility_area);
+    }
+    for (auto bitmap = set.queens; bitmap; bitmap &= bitmap - 1)
+    {
+        auto attacks = QueenAttacks::get_queen_attacks(Bitboard::get_lsb_index(bitmap), set.occupancy);
+        result.queens |= attacks;
+        result.mobility += Bitboard::count_bits(attacks & set.mobility_area);
+    }
+    return result;
+}
+
+template <int NUM_DIRECTIONS>
+static bitboard add_fills(const bitboard (&fills)[NUM_FILL_DIRECTIONS],
+                          const int (&directions)[NUM_DIRECTIONS], bitboard mobility_area, int &mobility)
+{
+    auto attacks = bitboard{};
+    for (auto direction : directions)
+    {
+        attacks |= fills[direction];
+        mobility += Bitboard::count_bits(fills[direction] & mobility_area);
+    }
+    return attacks;
+}
+
+//Same results as magic_slider_attacks with two occluded fills for the whole side
+template <typename Fill>
+static SliderAttacks fill_side_attacks(const SliderSet &set, Fill fill)
+{
+    auto result = SliderAttacks{};
+    bitboard fills[NUM_FILL_DIRECTIONS];
+    fill(set.rooks, set.bishops, ~set.occupancy, fills);
+    result.rooks = add_fills(fills, ORTHOGONAL_DIRECTIONS, set.mobility_area, result.mobility);
+    result.bishops = add_fills(fills, DIAGONAL_DIRECTIONS, set.mobility_area, result.mobility);
+    fill(set.queens, set.queens, ~set.occupancy, fills);
+    result.queens = add_fills(fills, ORTHOGONAL_DIRECTIONS, set.mobility_area, result.mobility) |
+                    add_fills(fills, DIAGONAL_DIRECTIONS, set.mobility_area, result.mobility);
+    return result;
+}
+
+//Times one slider attack path over several passes, returns side attack sets per second
+template <typename Generator>
+static long long time_slider_attacks(const std::vector<SliderSet> &sets, std::vector<SliderAttacks> &results,
+                                     Generator generator)
+{
+    auto start_time = UCITimer::get_time_ms();
+    for (auto pass = 0; pass < ATTACK_BENCH_PASSES; pass++)
+    {
+        for (size_t i = 0; i < sets.size(); i++)
+            results[i] = generator(sets[i]);
+    }
+    auto time = std::max(UCITimer::get_time_ms() - start_time, MINIMUM_TIME);
+    return static_cast<long long>(sets.size()) * ATTACK_BENCH_PASSES * MILLISECONDS_PER_SECOND / time;
+}
+
+Bench::AttackBenchResult Bench::run_attack_bench(int count)
+{
+    std::vector<SliderSet> sets;
+    sets.reserve(static_cast<size_t>(count) * NUM_SIDES);
+    collect_playout_positions(count, [&sets](std::shared_ptr<Boardstate> board_state)
+    {
+        auto pieces = board_state->get_piece_bitboards();
+        auto occupancies = board_state->get_occupancy_bitboards();
+        for (int side = white; side <= black; side++)
+        {
+            auto offset = (side == white) ? 0 : BLACK_PIECE_OFFSET;
+            sets.push_back(SliderSet{pieces[R + offset], pieces[B + offset], pieces[Q + offset],
+                                     occupancies[both], ~occupancies[side]});
+        }
+    });
+    auto result = AttackBenchResult{};
+    result.sides = static_cast<int>(sets.size());
+    std::vector<SliderAttacks> magic_results(sets.size()), scalar_results(sets.size()), simd_results(sets.size());
+    result.magic_rate = time_slider_attacks(sets, magic_results, magic_slider_attacks);
+    result.fill_rate = time_slider_attacks(sets, scalar_results, [](const SliderSet &set)
+        { return fill_side_attacks(set, fill_slider_attacks_scalar); });
+    result.simd_fill_rate = time_slider_attacks(sets, simd_results, [](const SliderSet &set)
+        { return fill_side_attacks(set, fill_slider_attacks); });
+    for (size_t i = 0; i < sets.size(); i++)
+        result.mismatches += (scalar_results[i] != magic_results[i]) + (simd_results[i] != magic_results[i]);
+    return result;
+}
@@ -0,0 +1,66 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <memory>
+#include <functional>
+
+#include "../BoardState.h"
+
+/** \file Bench.h
+    \brief Contains the benchmark positions and the evaluation and attack benchmarks
+ */
+
+//Benchmarks behind the non UCI "bench", "perft", "evalbench" and "attackbench" commands
+namespace Bench
+{
+    //Fixed positions so node counts can be compared between versions
+    inline constexpr const char* positions[] =
+    {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r2q1rk1/ppp2ppp/2n1bn2/2b1p3/3pP3/3P1NPP/PPP1NPB1/R1BQ1RK1 b - - 0 9",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        "6k1/5pp1/4p2p/3pP3/2pP4/2P2QPP/r4PK1/3q4 w - - 0 35"
+    };
+
+    //Passes count positions from seeded random playouts of the bench positions to collect,
+    //the same count always gives the same positions
+    void collect_playout_positions(int count, const std::function<void(std::shared_ptr<Boardstate>)> &collect);
+
+    class EvalBenchResult
+    {
+    public:
+        //Positions per second of each batch evaluation path
+        long long scalar_rate = 0;
+        long long simd_rate = 0;
+        long long threaded_rate = 0;
+        int threads = 1;
+        //Scores of the vectorised and threaded paths that differ from the scalar path
+        int mismatches = 0;
+    };
+
+    //Evaluates count playout positions with the scalar, vectorised and threaded batch paths
+    EvalBenchResult run_eval_bench(int count);
+
+    class AttackBenchResult
+    {
+    public:
+        //Number of slider sets, one per side of each position
+        int sides = 0;
+        //Slider sets per second of the magic lookups and the scalar and vectorised fills
+        long long magic_rate = 0;
+        long long fill_rate = 0;
+        long long simd_fill_rate = 0;
+        //Fill results that differ from the magic lookups
+        int mismatches = 0;
+    };
+
+    //Finds the attacks and mobility of all rooks, bishops and queens of each side in count
+    //playout positions, once by summing magic lookups per piece and once with occluded fills
+    AttackBenchResult run_attack_bench(int count);
+}
+
+#endif
@@ -21,7 +21,7 @@ void Bitboard::printBoard(bitboard bmap)
     printf("Bitboard: %llud \n\n", bmap);
 }
 
-bool Bitboard::get_bit(bitboard &bmap, const int square)
+bool Bitboard::get_bit(const bitboard &bmap, const int square)
 {
     auto bit = (bmap & (ONE_SHIFT << square)) ? true : false;
     return bit;
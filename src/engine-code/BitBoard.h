@@ -62,7 +62,7 @@ enum
 
 namespace Bitboard
 {
-    bool get_bit(bitboard &bmap,const int square);
+    bool get_bit(const bitboard &bmap,const int square);
     void set_bit(bitboard &bmap,const int square);
     void pop_bit(bitboard &bmap,const int square);
     void printBoard(const bitboard bmap);
@@ -1,4 +1,5 @@
 #include "BoardState.h"
+#include "Evaluation/NNUE.h"
 
 constexpr auto BOARD_SIZE = 8;
 constexpr auto SINGLE_ROW_SHIFT = 8;
@@ -79,10 +80,19 @@ void Boardstate::perft_display(int depth)
     perft_driver(depth);
     Timer::stop();
     printf("\nNumber of nodes: %llu\n", nodes_);
-    printf("\nTime taken: %d\n", Timer::readTime());
+    printf("\nTime taken: %lld\n", Timer::readTime());
     nodes_ = 0;
 }
 
+long long Boardstate::perft(int depth)
+{
+    nodes_ = 0;
+    perft_driver(depth);
+    auto nodes = nodes_;
+    nodes_ = 0;
+    return nodes;
+}
+
 void Boardstate::perft_test(int depth)
 {
     printf("    Performance Test: \n\n");
@@ -115,7 +125,7 @@ void Boardstate::perft_test(int depth)
     Timer::stop();
     printf("\n    Depth: %d\n", depth);
     printf("    Nodes: %llu\n", nodes_);
-    printf("    Time:  %ld\n", Timer::readTime());
+    printf("    Time:  %lld\n", Timer::readTime());
     nodes_ = 0;
 }
 
@@ -198,6 +208,261 @@ bool Boardstate::is_square_attacked(int square, int side_attacking)
     return false;
 }
 
+bitboard Boardstate::attackers_to(int square, bitboard occupancy)
+{
+    auto bishops_queens = piece_bitboards[B] | piece_bitboards[b] | piece_bitboards[Q] | piece_bitboards[q];
+    auto rooks_queens = piece_bitboards[R] | piece_bitboards[r] | piece_bitboards[Q] | piece_bitboards[q];
+    return (PawnAttacks::pawn_attacks[black][square] & piece_bitboards[P]) |
+           (PawnAttacks::pawn_attacks[white][square] & piece_bitboards[p]) |
+           (KnightAttacks::knight_attacks[square] & (piece_bitboards[N] | piece_bitboards[n])) |
+           (KingAttacks::king_attacks[square] & (piece_bitboards[K] | piece_bitboards[k])) |
+           (BishopAttacks::get_bishop_attacks(square, occupancy) & bishops_queens) |
+           (RookAttacks::get_rook_attacks(square, occupancy) & rooks_queens);
+}
+
+constexpr auto BLACK_PIECE_OFFSET = 6;
+constexpr auto TOP_LEFT_SHIFT = 9;
+constexpr auto TOP_RIGHT_SHIFT = 7;
+
+//Attacks of a whole pawn set, white pawns attack towards a8
+static inline bitboard pawn_set_attacks(bitboard pawns, int side)
+{
+    if (side == white)
+        return ((pawns >> TOP_LEFT_SHIFT) & PawnAttacks::NOT_H_FILE) |
+               ((pawns >> TOP_RIGHT_SHIFT) & PawnAttacks::NOT_A_FILE);
+    return ((pawns << TOP_RIGHT_SHIFT) & PawnAttacks::NOT_H_FILE) |
+           ((pawns << TOP_LEFT_SHIFT) & PawnAttacks::NOT_A_FILE);
+}
+
+void Boardstate::compute_attacks(int side)
+{
+    auto offset = (side == white) ? 0 : BLACK_PIECE_OFFSET;
+    auto enemy_offset = (side == white) ? BLACK_PIECE_OFFSET : 0;
+    auto occupancy = occupancy_bitboards[both];
+    auto mobility_area = ~occupancy_bitboards[side] & ~pawn_set_attacks(piece_bitboards[P + enemy_offset], side ^ 1);
+    auto &map = attack_map_;
+    map.by_piece[P + offset] = pawn_set_attacks(piece_bitboards[P + offset], side);
+    map.mobility[P + offset] = 0;
+    map.by_side[side] = map.by_piece[P + offset];
+    for (auto piece = N + offset; piece <= K + offset; piece++)
+    {
+        auto attacks = bitboard{};
+        auto mobility = 0;
+        auto bitmap = piece_bitboards[piece];
+        while (bitmap)
+        {
+            auto square = Bitboard::get_lsb_index(bitmap);
+            auto piece_attacks = get_attacks_from(piece - offset, square, occupancy);
+            attacks |= piece_attacks;
+            mobility += Bitboard::count_bits(piece_attacks & mobility_area);
+            Bitboard::pop_bit(bitmap, square);
+        }
+        map.by_piece[piece] = attacks;
+        map.mobility[piece] = mobility;
+        map.by_side[side] |= attacks;
+    }
+    map.computed[side] = true;
+}
+
+bitboard Boardstate::get_attacked_squares(int side)
+{
+    if (!attack_map_.computed[side])
+        compute_attacks(side);
+    return attack_map_.by_side[side];
+}
+
+bitboard Boardstate::get_piece_attacks(int piece)
+{
+    auto side = (piece <= K) ? white : black;
+    if (!attack_map_.computed[side])
+        compute_attacks(side);
+    return attack_map_.by_piece[piece];
+}
+
+int Boardstate::get_piece_mobility(int piece)
+{
+    auto side = (piece <= K) ? white : black;
+    if (!attack_map_.computed[side])
+        compute_attacks(side);
+    return attack_map_.mobility[piece];
+}
+
+bool Boardstate::is_in_check()
+{
+    return get_attacked_squares(side_to_move_ ^ CHANGE_COLOR) & piece_bitboards[(side_to_move_ == white) ? K : k];
+}
+
+bool Boardstate::is_square_covered(int square, int side)
+{
+    auto attacked = get_attacked_squares(side);
+    return Bitboard::get_bit(attacked, square);
+}
+
+bitboard Boardstate::get_attacks_from(int piece_type, int square, bitboard occupancy)
+{
+    switch (piece_type)
+    {
+        case (N): return KnightAttacks::knight_attacks[square];
+        case (B): return BishopAttacks::get_bishop_attacks(square, occupancy);
+        case (R): return RookAttacks::get_rook_attacks(square, occupancy);
+        case (Q): return QueenAttacks::get_queen_attacks(square, occupancy);
+        case (K): return KingAttacks::king_attacks[square];
+        default: return bitboard{};
+    }
+}
+
+static inline bool on_rank_or_file(int first_square, int second_square)
+{
+    return ((first_square / BOARD_SIZE) == (second_square / BOARD_SIZE)) ||
+           ((first_square % BOARD_SIZE) == (second_square % BOARD_SIZE));
+}
+
+//Squares strictly between two squares on a shared line, or on the whole line when
+//both are given as empty occupancy
+static inline bitboard squares_between(int first_square, int second_square, bitboard first, bitboard second)
+{
+    if (on_rank_or_file(first_square, second_square))
+        return RookAttacks::get_rook_attacks(first_square, first) & RookAttacks::get_rook_attacks(second_square, second);
+    return BishopAttacks::get_bishop_attacks(first_square, first) &
+           BishopAttacks::get_bishop_attacks(second_square, second);
+}
+
+CheckInfo Boardstate::get_check_info()
+{
+    auto info = CheckInfo{};
+    auto offset = (side_to_move_ == white) ? 0 : BLACK_PIECE_OFFSET;
+    auto king = Bitboard::get_lsb_index(piece_bitboards[(side_to_move_ == white) ? k : K]);
+    auto occupancy = occupancy_bitboards[both];
+    info.enemy_king_square = king;
+    info.check_squares[P] = PawnAttacks::pawn_attacks[side_to_move_ ^ CHANGE_COLOR][king];
+    for (int piece_type = N; piece_type < K; piece_type++)
+        info.check_squares[piece_type] = get_attacks_from(piece_type, king, occupancy);
+    auto rooks_queens = piece_bitboards[R + offset] | piece_bitboards[Q + offset];
+    auto bishops_queens = piece_bitboards[B + offset] | piece_bitboards[Q + offset];
+    auto snipers = (RookAttacks::get_rook_attacks(king, bitboard{}) & rooks_queens) |
+                   (BishopAttacks::get_bishop_attacks(king, bitboard{}) & bishops_queens);
+    while (snipers)
+    {
+        auto sniper = Bitboard::get_lsb_index(snipers);
+        Bitboard::pop_bit(snipers, sniper);
+        auto blockers = squares_between(sniper, king, 1ull << king, 1ull << sniper) & occupancy;
+        if ((Bitboard::count_bits(blockers) == 1) && (blockers & occupancy_bitboards[side_to_move_]))
+            info.discovered_check_candidates |= blockers;
+    }
+    return info;
+}
+
+bool Boardstate::gives_check(Move &move, CheckInfo &check_info)
+{
+    auto source_square = move.get_move_source_square();
+    auto target_square = move.get_move_target_square();
+    auto offset = (side_to_move_ == white) ? 0 : BLACK_PIECE_OFFSET;
+    auto piece_type = move.get_move_piece() - offset;
+    auto promotion_type = move.get_move_promotion_type();
+    auto king = check_info.enemy_king_square;
+    auto king_bit = 1ull << king;
+    //Direct check, a promoting pawn checks as its new piece below
+    if (!promotion_type && (check_info.check_squares[piece_type] & (1ull << target_square)))
+        return true;
+    //Discovered check unless the piece stays on the line to the king
+    if ((check_info.discovered_check_candidates & (1ull << source_square)) &&
+        !((squares_between(source_square, king, bitboard{}, bitboard{}) | king_bit) & (1ull << target_square)))
+        return true;
+    auto occupancy = (occupancy_bitboards[both] & ~(1ull << source_square)) | (1ull << target_square);
+    if (promotion_type)
+        return get_attacks_from(promotion_type - offset, target_square, occupancy) & king_bit;
+    //Taking en passant also empties the captured pawn's square, which can uncover a slider
+    if (move.get_move_en_passant_flag())
+    {
+        occupancy &= ~(1ull << ((side_to_move_ == white) ? target_square + SINGLE_ROW_SHIFT :
+                                                           target_square - SINGLE_ROW_SHIFT));
+        return (RookAttacks::get_rook_attacks(king, occupancy) & (piece_bitboards[R + offset] | piece_bitboards[Q + offset])) ||
+               (BishopAttacks::get_bishop_attacks(king, occupancy) & (piece_bitboards[B + offset] | piece_bitboards[Q + offset]));
+    }
+    //Only the rook can check after castling
+    if (move.get_move_castling_flag())
+    {
+        auto rook_source = (target_square == g1) ? h1 : (target_square == c1) ? a1 : (target_square == g8) ? h8 : a8;
+        auto rook_target = (source_square + target_square) / 2;
+        occupancy = (occupancy & ~(1ull << rook_source)) | (1ull << rook_target);
+        return RookAttacks::get_rook_attacks(rook_target, occupancy) & king_bit;
+    }
+    return false;
+}
+
+//Exchange values indexed by white piece, the king can never be captured
+constexpr int see_values[] = {100, 300, 350, 500, 1000, 20000};
+
+int Boardstate::least_valuable_attacker(bitboard attackers, int side)
+{
+    auto offset = (side == white) ? 0 : BLACK_PIECE_OFFSET;
+    for (int piece = P; piece <= K; piece++)
+    {
+        if (attackers & piece_bitboards[piece + offset])
+            return piece;
+    }
+    return NO_PIECE;
+}
+
+//Swap algorithm, each side recaptures with its least valuable piece and may stop when behind
+bool Boardstate::see(Move &move, int threshold)
+{
+    //Castling never captures and cannot be recaptured
+    if (move.get_move_castling_flag())
+        return threshold <= 0;
+    auto source_square = move.get_move_source_square();
+    auto target_square = move.get_move_target_square();
+    auto occupancy = occupancy_bitboards[both];
+    auto captured_value = 0;
+    if (move.get_move_en_passant_flag())
+    {
+        captured_value = see_values[P];
+        Bitboard::pop_bit(occupancy, (side_to_move_ == white) ? target_square + SINGLE_ROW_SHIFT :
+                                                                target_square - SINGLE_ROW_SHIFT);
+    }
+    else if (move.get_move_capture_flag())
+        captured_value = see_values[get_piece_on_square(target_square) % BLACK_PIECE_OFFSET];
+    //Even winning the captured piece for free does not reach the threshold
+    auto swap = captured_value - threshold;
+    if (swap < 0)
+        return false;
+    //Still reaches the threshold after losing the moving piece
+    swap = see_values[move.get_move_piece() % BLACK_PIECE_OFFSET] - swap;
+    if (swap <= 0)
+        return true;
+    Bitboard::pop_bit(occupancy, source_square);
+    Bitboard::pop_bit(occupancy, target_square);
+    auto attackers = attackers_to(target_square, occupancy);
+    auto bishops_queens = piece_bitboards[B] | piece_bitboards[b] | piece_bitboards[Q] | piece_bitboards[q];
+    auto rooks_queens = piece_bitboards[R] | piece_bitboards[r] | piece_bitboards[Q] | piece_bitboards[q];
+    auto side = side_to_move_;
+    auto result = 1;
+    while (true)
+    {
+        side ^= CHANGE_COLOR;
+        attackers &= occupancy;
+        auto side_attackers = attackers & occupancy_bitboards[side];
+        if (!side_attackers)
+            break;
+        result ^= 1;
+        auto piece = least_valuable_attacker(side_attackers, side);
+        //A king can only recapture if the other side has nothing left
+        if (piece == K)
+            return (attackers & ~occupancy_bitboards[side]) ? (result ^ 1) : result;
+        swap = see_values[piece] - swap;
+        if (swap < result)
+            break;
+        auto offset = (side == white) ? 0 : BLACK_PIECE_OFFSET;
+        Bitboard::pop_bit(occupancy, Bitboard::get_lsb_index(side_attackers & piece_bitboards[piece + offset]));
+        //Removing the attacker can uncover a slider behind it
+        if ((piece == P) || (piece == B) || (piece == Q))
+            attackers |= BishopAttacks::get_bishop_attacks(target_square, occupancy) & bishops_queens;
+        if ((piece == R) || (piece == Q))
+            attackers |= RookAttacks::get_rook_attacks(target_square, occupancy) & rooks_queens;
+    }
+    return result;
+}
+
 void Boardstate::print_attacked_squares(int side_attacking)
 {
     for (auto rank = 0; rank < 8; rank++)
@@ -280,6 +545,8 @@ bool Boardstate::make_move(Move &move, bool move_type)
         //Preserve board state
         BoardstateCopy copy_of_state;
         make_copy(copy_of_state);
+        if (NNUE::is_enabled())
+            push_accumulator();
 
         //Parse move info
         auto source_square = move.get_move_source_square();
@@ -291,21 +558,19 @@ bool Boardstate::make_move(Move &move, bool move_type)
         auto enpassant = move.get_move_en_passant_flag();
         auto castling = move.get_move_castling_flag();
 
-        //Make quiet moves
-        Bitboard::pop_bit(piece_bitboards[piece], source_square);
-        Bitboard::set_bit(piece_bitboards[piece], target_square);
-
-        //Increment halfmove count
-        halfmove_count_++;
-        //Handle reset halfmove if pawn move
-        if ((piece == P) || (piece == p))
-            halfmove_count_ = 0;
-        //Handle captues and reset halfmove
+        //Handle captures, the captured piece leaves before the moving piece lands on its square
         if (capture)
         {
-            remove_captured_pieces(target_square);
-            halfmove_count_ = 0;
+            remove_captured_piece(target_square);
         }
+        //Make quiet moves
+        remove_piece(piece, source_square);
+        add_piece(piece, target_square);
+        //Captures and pawn moves reset the halfmove count
+        if (capture || (piece == P) || (piece == p))
+            halfmove_count_ = 0;
+        else
+            halfmove_count_++;
         //Handle promotions
         handle_pawn_promotions(promotion_type, target_square);
         //Handle enpassant
@@ -314,6 +579,8 @@ bool Boardstate::make_move(Move &move, bool move_type)
             handle_en_passant_captures(target_square);
         }
         //Reset enpassant square
+        if (en_passant_square_ != no_sq)
+            hash_key_ ^= Zobrist::en_passant_keys[en_passant_square_];
         en_passant_square_ = no_sq;
         //Handle double pawn push
         if (double_push)
@@ -321,6 +588,7 @@ bool Boardstate::make_move(Move &move, bool move_type)
             //Set enpassant square
             (side_to_move_ == white) ? (en_passant_square_ = target_square + SINGLE_ROW_SHIFT) :
                                        (en_passant_square_ = target_square - SINGLE_ROW_SHIFT);
+            hash_key_ ^= Zobrist::en_passant_keys[en_passant_square_];
         }
         //Handle castling
         if (castling)
@@ -328,17 +596,18 @@ bool Boardstate::make_move(Move &move, bool move_type)
             handle_castling(target_square);
         }
         //Update castling rights after every move using predefined castling_rights[64] array
+        hash_key_ ^= Zobrist::castling_keys[castling_rights_];
         castling_rights_ &= castling_rights[source_square];
         castling_rights_ &= castling_rights[target_square];
-        //Update occupancy bitboards
-        update_occupancies();
+        hash_key_ ^= Zobrist::castling_keys[castling_rights_];
         //Update side to move
         side_to_move_ ^= CHANGE_COLOR;
-        //Ensure king is not in check
-        auto king_square = (side_to_move_ == white) ? Bitboard::get_lsb_index(piece_bitboards[k]) :
-                                                      Bitboard::get_lsb_index(piece_bitboards[K]);
+        hash_key_ ^= Zobrist::side_key;
+        //The attacks found here are kept for the new position
+        attack_map_.computed[white] = false;
+        attack_map_.computed[black] = false;
         //Make move if king not in check
-        if (is_square_attacked(king_square, side_to_move_))
+        if (get_attacked_squares(side_to_move_) & piece_bitboards[(side_to_move_ == white) ? k : K])
         {
             restore_copy(copy_of_state);
             return DONT_MAKE_MOVE;
@@ -347,6 +616,7 @@ bool Boardstate::make_move(Move &move, bool move_type)
         {
             //If it was just black to move then increment fullmove counter
             if (side_to_move_ == white) fullmove_count_++;
+            push_repetition();
             return MAKE_MOVE;
         }
     }
@@ -363,44 +633,30 @@ bool Boardstate::make_move(Move &move, bool move_type)
     return DONT_MAKE_MOVE;
 }
 
-void Boardstate::remove_captured_pieces(int target_square)
+void Boardstate::remove_captured_piece(int target_square)
 {
-    int start_piece, end_piece;
-    if (side_to_move_ == white)
-    {
-        start_piece = p;
-        end_piece = k;
-    }
-    else
-    {
-        start_piece = P;
-        end_piece = K;
-    }
-    for (auto bb_piece = start_piece; bb_piece <= end_piece; bb_piece++)
-    {
-    if (Bitboard::get_bit(piece_bitboards[bb_piece], target_square))
-        {
-            Bitboard::pop_bit(piece_bitboards[bb_piece], target_square);
-            return;
-        }
-    }
+    //En passant targets are empty, handle_en_passant_captures() removes that pawn
+    auto captured_piece = mailbox_[target_square];
+    if (captured_piece != NO_PIECE)
+        remove_piece(captured_piece, target_square);
 }
 
 void Boardstate::handle_pawn_promotions(int promoted_piece, int target_square)
 {
     if (promoted_piece)
     {
-        Bitboard::pop_bit(piece_bitboards[(side_to_move_ == white) ? P : p], target_square);
-        Bitboard::set_bit(piece_bitboards[promoted_piece], target_square);
+        auto pawn_piece = (side_to_move_ == white) ? P : p;
+        remove_piece(pawn_piece, target_square);
+        add_piece(promoted_piece, target_square);
     }
 }
 
 void Boardstate::handle_en_passant_captures(int target_square)
 {
     if (side_to_move_ == white)
-        Bitboard::pop_bit(piece_bitboards[p], target_square + SINGLE_ROW_SHIFT);
+        remove_piece(p, target_square + SINGLE_ROW_SHIFT);
     else
-        Bitboard::pop_bit(piece_bitboards[P], target_square - SINGLE_ROW_SHIFT);
+        remove_piece(P, target_square - SINGLE_ROW_SHIFT);
 }
 
 void Boardstate::handle_castling(int target_square)
@@ -409,74 +665,86 @@ void Boardstate::handle_castling(int target_square)
     {
         //White Kingside
         case (g1):
-            Bitboard::pop_bit(piece_bitboards[R], h1);
-            Bitboard::set_bit(piece_bitboards[R], f1);
+            remove_piece(R, h1);
+            add_piece(R, f1);
             break;
         //White Queenside
         case (c1):
-            Bitboard::pop_bit(piece_bitboards[R], a1);
-            Bitboard::set_bit(piece_bitboards[R], d1);
+            remove_piece(R, a1);
+            add_piece(R, d1);
             break;
         //Black Kingside
         case (g8):
-            Bitboard::pop_bit(piece_bitboards[r], h8);
-            Bitboard::set_bit(piece_bitboards[r], f8);
+            remove_piece(r, h8);
+            add_piece(r, f8);
             break;
         //Black Queenside
         case (c8):
-            Bitboard::pop_bit(piece_bitboards[r], a8);
-            Bitboard::set_bit(piece_bitboards[r], d8);
+            remove_piece(r, a8);
+            add_piece(r, d8);
             break;
         default:
             return;
     }
 }
 
-constexpr auto SHIFT_PIECE_INDEX_COLOR = 6;
-
-void Boardstate::update_occupancies()
-{
-    memset(occupancy_bitboards, bitboard{}, BYTES_IN_OCC_BITBOARD_ARR);
-    for (int bb_piece = P; bb_piece <= K; bb_piece++)
-    {
-        occupancy_bitboards[white] |= piece_bitboards[bb_piece];
-        occupancy_bitboards[black] |= piece_bitboards[bb_piece + SHIFT_PIECE_INDEX_COLOR];
-    }
-    occupancy_bitboards[both] = occupancy_bitboards[white] | occupancy_bitboards[black];
-}
-
 void Boardstate::operator=(Boardstate& oldBoardState)
 {
     //Use different method to sizeof to increase speed. Sizeof is the number of bytes
     memcpy(piece_bitboards, oldBoardState.get_piece_bitboards(), BYTES_IN_PIECE_BITBOARD_ARR);
     memcpy(occupancy_bitboards, oldBoardState.get_occupancy_bitboards(), BYTES_IN_OCC_BITBOARD_ARR);
+    memcpy(mailbox_, oldBoardState.mailbox_, sizeof(mailbox_));
     side_to_move_ = oldBoardState.get_side_to_move();
     en_passant_square_ = oldBoardState.get_en_passant_square();
     castling_rights_ = oldBoardState.get_castling_rights();
     halfmove_count_ = oldBoardState.get_halfmove_count();
     fullmove_count_ = oldBoardState.get_fullmove_count();
+    hash_key_ = oldBoardState.get_hash_key();
+    pawn_hash_key_ = oldBoardState.get_pawn_hash_key();
+    psqt_score_ = oldBoardState.get_psqt_score();
+    game_phase_ = oldBoardState.get_game_phase();
+    attack_map_ = oldBoardState.attack_map_;
+    memcpy(repetition_table_, oldBoardState.repetition_table_, sizeof(repetition_table_));
+    repetition_index_ = oldBoardState.repetition_index_;
+    reset_accumulators();
 }
 
 void Boardstate::make_copy(BoardstateCopy &copy_of_state)
 {
     memcpy(copy_of_state.piece_bitboards, piece_bitboards, BYTES_IN_PIECE_BITBOARD_ARR);
     memcpy(copy_of_state.occupancy_bitboards, occupancy_bitboards, BYTES_IN_OCC_BITBOARD_ARR);
+    memcpy(copy_of_state.mailbox_, mailbox_, sizeof(mailbox_));
     copy_of_state.side_to_move_ = side_to_move_;
     copy_of_state.en_passant_square_ = en_passant_square_;
     copy_of_state.castling_rights_ = castling_rights_;
     copy_of_state.halfmove_count_ = halfmove_count_;
     copy_of_state.fullmove_count_ = fullmove_count_;
+    copy_of_state.hash_key_ = hash_key_;
+    copy_of_state.pawn_hash_key_ = pawn_hash_key_;
+    copy_of_state.repetition_index_ = repetition_index_;
+    copy_of_state.accumulator_index_ = accumulator_index_;
+    copy_of_state.psqt_score_ = psqt_score_;
+    copy_of_state.game_phase_ = game_phase_;
+    copy_of_state.attack_map_ = attack_map_;
 }
 
 void Boardstate::restore_copy(BoardstateCopy &copy_of_state)
 {
     memcpy(piece_bitboards, copy_of_state.piece_bitboards, BYTES_IN_PIECE_BITBOARD_ARR);
     memcpy(occupancy_bitboards, copy_of_state.occupancy_bitboards, BYTES_IN_OCC_BITBOARD_ARR);
+    memcpy(mailbox_, copy_of_state.mailbox_, sizeof(mailbox_));
     side_to_move_ = copy_of_state.side_to_move_;
     en_passant_square_ = copy_of_state.en_passant_square_;
     castling_rights_ = copy_of_state.castling_rights_;
     halfmove_count_ = copy_of_state.halfmove_count_;
     fullmove_count_ = copy_of_state.fullmove_count_;
+    hash_key_ = copy_of_state.hash_key_;
+    pawn_hash_key_ = copy_of_state.pawn_hash_key_;
+    repetition_index_ = copy_of_state.repetition_index_;
+    accumulator_index_ = copy_of_state.accumulator_index_;
+    psqt_score_ = copy_of_state.psqt_score_;
+    game_phase_ = copy_of_state.game_phase_;
+    attack_map_ = copy_of_state.attack_map_;
 }
 
 //Getters
@@ -520,6 +788,336 @@ unsigned int Boardstate::get_fullmove_count()
     return fullmove_count_;
 }
 
+bitboard Boardstate::get_hash_key()
+{
+    return hash_key_;
+}
+
+bitboard Boardstate::get_pawn_hash_key()
+{
+    return pawn_hash_key_;
+}
+
+BasicEval::Score Boardstate::get_psqt_score()
+{
+    return psqt_score_;
+}
+
+int Boardstate::get_game_phase()
+{
+    return game_phase_;
+}
+
+BasicEval::Score Boardstate::generate_psqt_score()
+{
+    auto score = BasicEval::Score{};
+    for (int bb_piece = P; bb_piece <= k; bb_piece++)
+    {
+        auto bitmap = piece_bitboards[bb_piece];
+        while (bitmap)
+        {
+            auto square = Bitboard::get_lsb_index(bitmap);
+            score += BasicEval::psqt.scores[bb_piece][square];
+            Bitboard::pop_bit(bitmap, square);
+        }
+    }
+    return score;
+}
+
+int Boardstate::generate_game_phase()
+{
+    auto phase = 0;
+    for (int bb_piece = P; bb_piece <= k; bb_piece++)
+        phase += BasicEval::phase_weights[bb_piece] * Bitboard::count_bits(piece_bitboards[bb_piece]);
+    return phase;
+}
+
+bitboard Boardstate::generate_pawn_hash_key()
+{
+    auto key = bitboard{};
+    for (auto bb_piece : {P, p})
+    {
+        auto bitmap = piece_bitboards[bb_piece];
+        while (bitmap)
+        {
+            auto square = Bitboard::get_lsb_index(bitmap);
+            key ^= Zobrist::piece_keys[bb_piece][square];
+            Bitboard::pop_bit(bitmap, square);
+        }
+    }
+    return key;
+}
+
+bitboard Boardstate::generate_hash_key()
+{
+    auto key = bitboard{};
+    for (int bb_piece = P; bb_piece <= k; bb_piece++)
+    {
+        auto bitmap = piece_bitboards[bb_piece];
+        while (bitmap)
+        {
+            auto square = Bitboard::get_lsb_index(bitmap);
+            key ^= Zobrist::piece_keys[bb_piece][square];
+            Bitboard::pop_bit(bitmap, square);
+        }
+    }
+    if (en_passant_square_ != no_sq)
+        key ^= Zobrist::en_passant_keys[en_passant_square_];
+    key ^= Zobrist::castling_keys[castling_rights_];
+    if (side_to_move_ == black)
+        key ^= Zobrist::side_key;
+    return key;
+}
+
+void Boardstate::make_null_move()
+{
+    if (en_passant_square_ != no_sq)
+        hash_key_ ^= Zobrist::en_passant_keys[en_passant_square_];
+    en_passant_square_ = no_sq;
+    side_to_move_ ^= CHANGE_COLOR;
+    hash_key_ ^= Zobrist::side_key;
+    //Repetitions are not counted across a null move
+    halfmove_count_ = 0;
+    push_repetition();
+}
+
+void Boardstate::push_repetition()
+{
+    //The index keeps counting, only the last MAX_GAME_PLY positions are stored
+    repetition_table_[++repetition_index_ & (MAX_GAME_PLY - 1)] = hash_key_;
+}
+
+void Boardstate::push_accumulator()
+{
+    //Games longer than the stack start over, the next evaluation refreshes from scratch
+    accumulator_index_ = (accumulator_index_ + 1 < ACCUMULATOR_STACK_SIZE) ? accumulator_index_ + 1 : 0;
+    auto &accumulator = accumulators_[accumulator_index_];
+    accumulator.computed = false;
+    accumulator.num_added = 0;
+    accumulator.num_removed = 0;
+}
+
+void Boardstate::add_piece(int piece, int square)
+{
+    auto square_bit = 1ull << square;
+    auto side = (piece <= K) ? white : black;
+    piece_bitboards[piece] |= square_bit;
+    occupancy_bitboards[side] ^= square_bit;
+    occupancy_bitboards[both] ^= square_bit;
+    mailbox_[square] = piece;
+    hash_key_ ^= Zobrist::piece_keys[piece][square];
+    if ((piece == P) || (piece == p))
+        pawn_hash_key_ ^= Zobrist::piece_keys[piece][square];
+    if (NNUE::is_enabled())
+    {
+        auto &accumulator = accumulators_[accumulator_index_];
+        accumulator.added[accumulator.num_added++] = piece * NUM_SQUARES + square;
+    }
+    psqt_score_ += BasicEval::psqt.scores[piece][square];
+    game_phase_ += BasicEval::phase_weights[piece];
+}
+
+void Boardstate::remove_piece(int piece, int square)
+{
+    auto square_bit = 1ull << square;
+    auto side = (piece <= K) ? white : black;
+    piece_bitboards[piece] &= ~square_bit;
+    occupancy_bitboards[side] ^= square_bit;
+    occupancy_bitboards[both] ^= square_bit;
+    mailbox_[square] = NO_PIECE;
+    hash_key_ ^= Zobrist::piece_keys[piece][square];
+    if ((piece == P) || (piece == p))
+        pawn_hash_key_ ^= Zobrist::piece_keys[piece][square];
+    if (NNUE::is_enabled())
+    {
+        auto &accumulator = accumulators_[accumulator_index_];
+        accumulator.removed[accumulator.num_removed++] = piece * NUM_SQUARES + square;
+    }
+    psqt_score_ -= BasicEval::psqt.scores[piece][square];
+    game_phase_ -= BasicEval::phase_weights[piece];
+}
+
+void Boardstate::reset_accumulators()
+{
+    accumulator_index_ = 0;
+    accumulators_[accumulator_index_].computed = false;
+}
+
+Accumulator* Boardstate::get_accumulators()
+{
+    return accumulators_.data();
+}
+
+int Boardstate::get_accumulator_index()
+{
+    return accumulator_index_;
+}
+
+constexpr auto SAME_SIDE_STEP = 2;
+
+bool Boardstate::is_repetition()
+{
+    //Only positions since the last capture or pawn move can repeat, and only those still in the table
+    auto reversible_plies = std::min(static_cast<int>(halfmove_count_), MAX_GAME_PLY - 1);
+    auto oldest = std::max(repetition_index_ - reversible_plies, 0);
+    for (auto index = repetition_index_ - SAME_SIDE_STEP; index >= oldest; index -= SAME_SIDE_STEP)
+    {
+        if (repetition_table_[index & (MAX_GAME_PLY - 1)] == hash_key_)
+            return true;
+    }
+    return false;
+}
+
+int Boardstate::get_piece_on_square(int square)
+{
+    return mailbox_[square];
+}
+
+constexpr auto DOUBLE_PUSH_DISTANCE = 16;
+constexpr auto CASTLE_DISTANCE = 2;
+
+Move Boardstate::build_move(int source_square, int target_square, int promotion_piece)
+{
+    auto piece = get_piece_on_square(source_square);
+    if (piece == NO_PIECE)
+        return Move{};
+    auto is_pawn = (piece == P) || (piece == p);
+    auto is_king = (piece == K) || (piece == k);
+    auto capture = Bitboard::get_bit(occupancy_bitboards[side_to_move_ ^ CHANGE_COLOR], target_square);
+    auto double_push = is_pawn && (std::abs(target_square - source_square) == DOUBLE_PUSH_DISTANCE);
+    auto en_passant = is_pawn && (en_passant_square_ != no_sq) && (target_square == en_passant_square_);
+    auto castling = is_king && (std::abs(target_square - source_square) == CASTLE_DISTANCE);
+    return Move{source_square, target_square, piece, promotion_piece,
+                capture || en_passant, double_push, en_passant, castling};
+}
+
+Move Boardstate::build_move(PackedMove move)
+{
+    if (move.is_no_move())
+        return Move{};
+    auto promotion_piece = move.get_move_promotion_type();
+    if (promotion_piece && (side_to_move_ == black))
+        promotion_piece += BLACK_PIECE_OFFSET;
+    return build_move(move.get_move_source_square(), move.get_move_target_square(), promotion_piece);
+}
+
+bool Boardstate::is_pseudo_legal(Move &move)
+{
+    if (move.is_no_move())
+        return false;
+    auto source_square = move.get_move_source_square();
+    auto target_square = move.get_move_target_square();
+    auto piece = move.get_move_piece();
+    //Piece must be on the board and belong to the side to move
+    if ((piece < P) || (piece > k))
+        return false;
+    if ((side_to_move_ == white) != (piece <= K))
+        return false;
+    if (!Bitboard::get_bit(piece_bitboards[piece], source_square))
+        return false;
+    //Cannot capture own pieces
+    if (Bitboard::get_bit(occupancy_bitboards[side_to_move_], target_square))
+        return false;
+    if ((piece == P) || (piece == p))
+        return is_pseudo_legal_pawn_move(move);
+    //Only pawns can promote, push or capture en passant
+    if (move.get_move_promotion_type() || move.get_move_double_push_flag() || move.get_move_en_passant_flag())
+        return false;
+    //Capture flag must match the target square
+    if (move.get_move_capture_flag() != Bitboard::get_bit(occupancy_bitboards[side_to_move_ ^ CHANGE_COLOR], target_square))
+        return false;
+    if (move.get_move_castling_flag())
+        return ((piece == K) || (piece == k)) && !move.get_move_capture_flag() && is_pseudo_legal_castle(target_square);
+    auto attacks = bitboard{};
+    switch (piece)
+    {
+        case (N): case (n): attacks = KnightAttacks::knight_attacks[source_square]; break;
+        case (B): case (b): attacks = BishopAttacks::get_bishop_attacks(source_square, occupancy_bitboards[both]); break;
+        case (R): case (r): attacks = RookAttacks::get_rook_attacks(source_square, occupancy_bitboards[both]); break;
+        case (Q): case (q): attacks = QueenAttacks::get_queen_attacks(source_square, occupancy_bitboards[both]); break;
+        case (K): case (k): attacks = KingAttacks::king_attacks[source_square]; break;
+        default: return false;
+    }
+    return Bitboard::get_bit(attacks, target_square);
+}
+
+bool Boardstate::is_pseudo_legal_pawn_move(Move &move)
+{
+    auto source_square = move.get_move_source_square();
+    auto target_square = move.get_move_target_square();
+    auto promotion_piece = move.get_move_promotion_type();
+    auto enemy_occupied = Bitboard::get_bit(occupancy_bitboards[side_to_move_ ^ CHANGE_COLOR], target_square);
+    auto push_direction = (side_to_move_ == white) ? -SINGLE_ROW_SHIFT : SINGLE_ROW_SHIFT;
+    auto start_rank = (side_to_move_ == white) ? (source_square >= a2 && source_square <= h2) :
+                                                 (source_square >= a7 && source_square <= h7);
+    auto last_rank = (side_to_move_ == white) ? (target_square <= h8) : (target_square >= a1);
+    if (move.get_move_castling_flag())
+        return false;
+    //Pawns reaching the last rank must promote to a knight, bishop, rook or queen of their own color
+    if (last_rank)
+    {
+        auto first_promotion = (side_to_move_ == white) ? N : n;
+        if ((promotion_piece < first_promotion) || (promotion_piece > first_promotion + (Q - N)))
+            return false;
+    }
+    else if (promotion_piece)
+        return false;
+    //En passant captures
+    if (move.get_move_en_passant_flag())
+    {
+        return (target_square == en_passant_square_) && move.get_move_capture_flag() &&
+               !move.get_move_double_push_flag() &&
+               Bitboard::get_bit(PawnAttacks::pawn_attacks[side_to_move_][source_square], target_square) &&
+               Bitboard::get_bit(piece_bitboards[(side_to_move_ == white) ? p : P], target_square - push_direction);
+    }
+    //Normal captures
+    if (move.get_move_capture_flag())
+    {
+        return enemy_occupied && !move.get_move_double_push_flag() &&
+               Bitboard::get_bit(PawnAttacks::pawn_attacks[side_to_move_][source_square], target_square);
+    }
+    //Pushes must land on empty squares
+    if (enemy_occupied)
+        return false;
+    if (move.get_move_double_push_flag())
+    {
+        return start_rank && (target_square == source_square + 2 * push_direction) &&
+               !Bitboard::get_bit(occupancy_bitboards[both], source_square + push_direction);
+    }
+    return target_square == source_square + push_direction;
+}
+
+//Same conditions as generate_white_king_castle() and generate_black_king_castle()
+bool Boardstate::is_pseudo_legal_castle(int target_square)
+{
+    auto &occupancy = occupancy_bitboards[both];
+    switch (target_square)
+    {
+        case (g1):
+            return (side_to_move_ == white) && (castling_rights_ & wk) && Bitboard::get_bit(piece_bitboards[K], e1) &&
+                   Bitboard::get_bit(piece_bitboards[R], h1) &&
+                   !Bitboard::get_bit(occupancy, f1) && !Bitboard::get_bit(occupancy, g1) &&
+                   !is_square_covered(e1, black) && !is_square_covered(f1, black);
+        case (c1):
+            return (side_to_move_ == white) && (castling_rights_ & wq) && Bitboard::get_bit(piece_bitboards[K], e1) &&
+                   Bitboard::get_bit(piece_bitboards[R], a1) && !Bitboard::get_bit(occupancy, d1) &&
+                   !Bitboard::get_bit(occupancy, c1) && !Bitboard::get_bit(occupancy, b1) &&
+                   !is_square_covered(e1, black) && !is_square_covered(d1, black);
+        case (g8):
+            return (side_to_move_ == black) && (castling_rights_ & bk) && Bitboard::get_bit(piece_bitboards[k], e8) &&
+                   Bitboard::get_bit(piece_bitboards[r], h8) &&
+                   !Bitboard::get_bit(occupancy, f8) && !Bitboard::get_bit(occupancy, g8) &&
+                   !is_square_covered(e8, white) && !is_square_covered(f8, white);
+        case (c8):
+            return (side_to_move_ == black) && (castling_rights_ & bq) && Bitboard::get_bit(piece_bitboards[k], e8) &&
+                   Bitboard::get_bit(piece_bitboards[r], a8) && !Bitboard::get_bit(occupancy, d8) &&
+                   !Bitboard::get_bit(occupancy, c8) && !Bitboard::get_bit(occupancy, b8) &&
+                   !is_square_covered(e8, white) && !is_square_covered(d8, white);
+        default:
+            return false;
+    }
+}
+
 int Boardstate::get_num_moves(MoveList &move_list)
 {
     move_list.get_num_moves();
@@ -706,7 +1304,7 @@ void Boardstate::generate_white_king_castle(MoveList &move_list)
             {
                 //Ensure e1 is not attacked and f1 square is not attacked
                 //Thus king does not pass through check. g1 is checked in make_move() function
-                if ((!is_square_attacked(e1, black)) && (!is_square_attacked(f1, black)))
+                if ((!is_square_covered(e1, black)) && (!is_square_covered(f1, black)))
                 {
                     //White kingside castle
                     move_list.add_move(Move{e1, g1, K, false, false, false, false, true});
@@ -722,7 +1320,7 @@ void Boardstate::generate_white_king_castle(MoveList &move_list)
             {
                 //Ensure e1 is not attacked and f1 square is not attacked
                 //Thus king does not pass through check. g1 is checked in make_move() function
-                if ((!is_square_attacked(e1, black)) && (!is_square_attacked(d1, black)))
+                if ((!is_square_covered(e1, black)) && (!is_square_covered(d1, black)))
                 {
                     //White queenside castle
                     move_list.add_move(Move{e1, c1, K, false, false, false, false, true});
@@ -750,7 +1348,7 @@ void Boardstate::generate_black_king_castle(MoveList &move_list)
             {
                 //Ensure e1 is not attacked and f1 square is not attacked
                 //Thus king does not pass through check. g1 is checked in make_move() function
-                if ((!is_square_attacked(e8, white)) && (!is_square_attacked(f8, white)))
+                if ((!is_square_covered(e8, white)) && (!is_square_covered(f8, white)))
                 {
                     //Black kingside castle
                     move_list.add_move(Move{e8, g8, k, false, false, false, false, true});
@@ -766,7 +1364,7 @@ void Boardstate::generate_black_king_castle(MoveList &move_list)
             {
                 //Ensure e1 is not attacked and f1 square is not attacked
                 //Thus king does not pass through check. g1 is checked in make_move() function
-                if ((!is_square_attacked(e8, white)) && (!is_square_attacked(d8, white)))
+                if ((!is_square_covered(e8, white)) && (!is_square_covered(d8, white)))
                 {
                     //Black queenside castle
                     move_list.add_move(Move{e8, c8, k, false, false, false, false, true});
@@ -1093,6 +1691,24 @@ void Boardstate::FEN_parse(std::string fen)
         occupancy_bitboards[black] |= piece_bitboards[iCount];
     }
     occupancy_bitboards[both] = occupancy_bitboards[white] | occupancy_bitboards[black];
+    //Populate the mailbox
+    for (int bb_piece = P; bb_piece <= k; bb_piece++)
+    {
+        auto bitmap = piece_bitboards[bb_piece];
+        while (bitmap)
+        {
+            auto square = Bitboard::get_lsb_index(bitmap);
+            mailbox_[square] = bb_piece;
+            Bitboard::pop_bit(bitmap, square);
+        }
+    }
+    //Hash the parsed position and start the repetition history from it
+    hash_key_ = generate_hash_key();
+    pawn_hash_key_ = generate_pawn_hash_key();
+    psqt_score_ = generate_psqt_score();
+    game_phase_ = generate_game_phase();
+    repetition_index_ = 0;
+    repetition_table_[repetition_index_] = hash_key_;
 }
 
 /*
@@ -1212,9 +1828,17 @@ void Boardstate::clear_boardstate()
 {
     memset(piece_bitboards, bitboard{}, sizeof(piece_bitboards));
     memset(occupancy_bitboards, bitboard{}, sizeof(occupancy_bitboards));
+    memset(mailbox_, NO_PIECE, sizeof(mailbox_));
     side_to_move_ = white;
     en_passant_square_ = no_sq;
     castling_rights_ = NO_CASTLES;
     fullmove_count_ = 0u;
     halfmove_count_ = 0u;
+    hash_key_ = bitboard{};
+    pawn_hash_key_ = bitboard{};
+    psqt_score_ = 0;
+    game_phase_ = 0;
+    attack_map_ = AttackMap{};
+    repetition_index_ = 0;
+    reset_accumulators();
 }
@@ -9,17 +9,27 @@
 #include "Pieces/Queen.h"
 #include "Pieces/King.h"
 #include "Magic.h"
+#include "Zobrist.h"
 #include "Move.h"
 #include "Timer.h"
+#include "Evaluation/Accumulator.h"
+#include "Evaluation/PSQT.h"
 #include <map>
+#include <vector>
 #include <string.h>
 #include <algorithm>
+#include <cstdlib>
 #include <sstream>
 #include <iostream>
 
 constexpr auto NUM_PIECE_BITBOARDS = 12;
 constexpr auto NUM_OCC_BITBOARDS = 3;
 constexpr auto NO_CASTLES = 0;
+constexpr auto NUM_SIDES = 2;
+constexpr auto NUM_BOARD_SQUARES = 64;
+//Number of positions kept for repetition detection, the table is a ring buffer so it must be a power of two
+constexpr auto MAX_GAME_PLY = 1024;
+static_assert((MAX_GAME_PLY & (MAX_GAME_PLY - 1)) == 0, "MAX_GAME_PLY must be a power of two");
 
 /*
     The enum of the castling rights is given below
@@ -75,6 +85,31 @@ inline const std::map<char, int> char_pieces = {
 
 enum { all_moves = false, captures_only = true};
 
+//Squares attacked by each side, filled in on first use per side so move legality,
+//check detection and evaluation of the same position share the attack lookups
+class AttackMap
+{
+public:
+    //Attacks of all pieces of one type together
+    bitboard by_piece[NUM_PIECE_BITBOARDS] = {bitboard{}};
+    bitboard by_side[NUM_SIDES] = {bitboard{}};
+    //Attacked squares free of own pieces and enemy pawn attacks, summed over the pieces of a type
+    int mobility[NUM_PIECE_BITBOARDS] = {0};
+    bool computed[NUM_SIDES] = {false, false};
+};
+
+//What the side to move needs to know to find checking moves without making them,
+//computed once per node by Boardstate::get_check_info()
+class CheckInfo
+{
+public:
+    //Squares from which each piece type, indexed by white piece, attacks the enemy king
+    bitboard check_squares[NUM_PIECE_BITBOARDS / NUM_SIDES] = {bitboard{}};
+    //Own pieces that are the only blocker between an own slider and the enemy king
+    bitboard discovered_check_candidates = bitboard{};
+    int enemy_king_square = no_sq;
+};
+
 //A copy of relevant board state information to use in copy/make move functions of BoardState
 class BoardstateCopy
 {
@@ -85,11 +120,19 @@ public:
     //These define the board state in its entirety
     bitboard piece_bitboards[NUM_PIECE_BITBOARDS] = {bitboard{}};
     bitboard occupancy_bitboards[NUM_OCC_BITBOARDS] = {bitboard{}};
+    int8_t mailbox_[NUM_BOARD_SQUARES] = {0};
     int side_to_move_ = white;
     int en_passant_square_ = no_sq;
     int castling_rights_ = NO_CASTLES;
     unsigned int halfmove_count_ = 0u;
     unsigned int fullmove_count_ = 0u;
+    bitboard hash_key_ = bitboard{};
+    bitboard pawn_hash_key_ = bitboard{};
+    int repetition_index_ = 0;
+    int accumulator_index_ = 0;
+    BasicEval::Score psqt_score_ = 0;
+    int game_phase_ = 0;
+    AttackMap attack_map_;
 };
 
 class Boardstate
@@ -102,11 +145,23 @@ public:
     void set_en_passant_square(int square);
     void generate_moves(MoveList &move_list);
     bool make_move(Move &move, bool move_type);
+    //Passes the turn, used by null move pruning
+    void make_null_move();
+    //Builds a full move from its squares, the flags are read from the board
+    Move build_move(int source_square, int target_square, int promotion_piece);
+    Move build_move(PackedMove move);
+    //Checks that a move could have been generated in this position,
+    //make_move still has to check that the king is not left in check
+    bool is_pseudo_legal(Move &move);
+    //True if the position occurred before since the last irreversible move
+    bool is_repetition();
     void operator=(Boardstate& oldBoardState);
 
     void perft_display(int depth);
     void perft_driver(int depth);
     void perft_test(int depth);
+    //Leaf count of the move tree to the depth
+    long long perft(int depth);
 
     //Copy/Make approach helper functions
     void make_copy(BoardstateCopy &copy_of_state);
@@ -120,11 +175,44 @@ public:
     int get_castling_rights();
     unsigned int get_halfmove_count();
     unsigned int get_fullmove_count();
+    bitboard get_hash_key();
+    bitboard get_pawn_hash_key();
+    //Packed midgame and endgame material and piece square score from white's point of view
+    BasicEval::Score get_psqt_score();
+    int get_game_phase();
+    int get_piece_on_square(int square);
     int get_num_moves(MoveList &move_list);
+    //Accumulator of the current position is at get_accumulators()[get_accumulator_index()]
+    Accumulator* get_accumulators();
+    int get_accumulator_index();
+    //Starts the accumulator stack over at the current position
+    void reset_accumulators();
+
+    //Hashes the whole board from scratch, make_move updates the key incrementally
+    bitboard generate_hash_key();
+    //Hashes only the pawns of both sides, keys the pawn structure evaluation
+    bitboard generate_pawn_hash_key();
+    //Sum the piece square score and game phase from scratch, make_move updates them incrementally
+    BasicEval::Score generate_psqt_score();
+    int generate_game_phase();
 
     //Checking for attacked squares
     //Make faster by making static inline
     bool is_square_attacked(int square, int side_attacking);
+    //Pieces of both colors attacking a square, sliders are blocked by the given occupancy
+    bitboard attackers_to(int square, bitboard occupancy);
+    //Attack maps of the current position, computed on first use
+    bitboard get_attacked_squares(int side);
+    bitboard get_piece_attacks(int piece);
+    int get_piece_mobility(int piece);
+    //True if the side to move is in check
+    bool is_in_check();
+    //Check squares and discovered check candidates of the side to move
+    CheckInfo get_check_info();
+    //True if the move checks the enemy king, read from the position's CheckInfo
+    bool gives_check(Move &move, CheckInfo &check_info);
+    //Static exchange evaluation, true if the exchange started by the move gains at least threshold
+    bool see(Move &move, int threshold);
 
 private:
     //----------------//
@@ -137,11 +225,28 @@ private:
     void clear_boardstate();
 
     //Make move helper functions
-    void remove_captured_pieces(int target_square);
+    void remove_captured_piece(int target_square);
     void handle_pawn_promotions(int promoted_piece, int target_square);
     void handle_en_passant_captures(int target_square);
     void handle_castling(int target_square);
-    void update_occupancies();
+    void push_repetition();
+    void push_accumulator();
+    //The only way make_move changes the pieces, these keep the occupancies, the mailbox,
+    //the hash keys and the incrementally updated evaluation terms in step
+    void add_piece(int piece, int square);
+    void remove_piece(int piece, int square);
+
+    //Pseudo legality helper functions
+    bool is_pseudo_legal_pawn_move(Move &move);
+    bool is_pseudo_legal_castle(int target_square);
+
+    //Attack map helper functions
+    void compute_attacks(int side);
+    bool is_square_covered(int square, int side);
+    bitboard get_attacks_from(int piece_type, int square, bitboard occupancy);
+
+    //Static exchange helper functions
+    int least_valuable_attacker(bitboard attackers, int side);
 
     //Checking for attacked squares
     //Make faster by making static inline
@@ -171,11 +276,31 @@ private:
     //These define the board state in its entirety
     bitboard piece_bitboards[NUM_PIECE_BITBOARDS] = {bitboard{}};
     bitboard occupancy_bitboards[NUM_OCC_BITBOARDS] = {bitboard{}};
+    //Piece on each square or NO_PIECE, kept with the bitboards for direct lookups
+    int8_t mailbox_[NUM_BOARD_SQUARES] = {0};
     int side_to_move_ = white;
     int en_passant_square_ = no_sq;
     int castling_rights_ = NO_CASTLES;
     unsigned int halfmove_count_ = 0u;
     unsigned int fullmove_count_ = 0u;
+    bitboard hash_key_ = bitboard{};
+    bitboard pawn_hash_key_ = bitboard{};
+
+    //Hash keys of the positions of the game and search so far, kept as a ring buffer of the
+    //last MAX_GAME_PLY positions. Restoring a copy restores the index and thus pops the table
+    bitboard repetition_table_[MAX_GAME_PLY] = {bitboard{}};
+    int repetition_index_ = 0;
+
+    //Neural network accumulators of the positions on the way to the current one,
+    //restoring a copy pops the stack the same way as the repetition table
+    std::vector<Accumulator> accumulators_ = std::vector<Accumulator>(ACCUMULATOR_STACK_SIZE);
+    int accumulator_index_ = 0;
+
+    BasicEval::Score psqt_score_ = 0;
+    int game_phase_ = 0;
+
+    //Cleared whenever the pieces move, restoring a copy restores it
+    AttackMap attack_map_;
 
     //Perft node count
     long long nodes_ = 0;
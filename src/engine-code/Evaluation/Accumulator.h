@@ -0,0 +1,34 @@
+#ifndef ACCUMULATOR_H
+#define ACCUMULATOR_H
+
+#include <cstdint>
+
+/** \file Accumulator.h
+    \brief Contains the first layer accumulator of the neural network evaluation
+ */
+
+//One input per piece type on each square
+constexpr int NNUE_INPUT_SIZE = 768;
+constexpr int NNUE_HIDDEN_SIZE = 256;
+//A move adds or removes at most three pieces (capture promotions and castling)
+constexpr int MAX_DIRTY_FEATURES = 3;
+//Deeper than the search can reach, the stack starts over at every search root
+constexpr int ACCUMULATOR_STACK_SIZE = 128;
+constexpr int NNUE_PERSPECTIVES = 2;
+
+//First layer outputs of one position seen from both sides. make_move only records
+//which inputs changed, the values are brought up to date from the nearest computed
+//ancestor when the position is evaluated.
+class Accumulator
+{
+public:
+    alignas(32) int16_t values[NNUE_PERSPECTIVES][NNUE_HIDDEN_SIZE];
+    bool computed = false;
+    //Inputs switched on and off by the move that reached this position, white's point of view
+    int num_added = 0;
+    int num_removed = 0;
+    int added[MAX_DIRTY_FEATURES];
+    int removed[MAX_DIRTY_FEATURES];
+};
+
+#endif
@@ -1,53 +1,218 @@
 #include "BasicEval.h"
+#include "PawnTable.h"
+#include "EvalCache.h"
+#include "NNUE.h"
 
-int BasicEval::evaluate(std::shared_ptr<Boardstate> board_state)
+static int lazy_margin = BasicEval::DEFAULT_LAZY_MARGIN;
+static long long lazy_exits = 0;
+static long long full_evaluations = 0;
+
+int BasicEval::evaluate(std::shared_ptr<Boardstate> board_state, int alpha, int beta)
+{
+    //Positions reached again through transpositions are not evaluated twice
+    auto key = board_state->get_hash_key();
+    auto cached_score = 0;
+    if (EvalCache::probe(key, cached_score))
+        return cached_score;
+    //The network replaces the tables below once weights are loaded
+    if (NNUE::is_enabled())
+    {
+        auto network_score = NNUE::evaluate(board_state);
+        EvalCache::store(key, network_score);
+        return network_score;
+    }
+    //Material and piece squares are kept up to date by make_move
+    auto psqt_score = board_state->get_psqt_score();
+    auto phase = board_state->get_game_phase();
+    auto final_score = taper(psqt_score, phase);
+    //The remaining terms cannot bring a score this far outside the window back into it,
+    //lazy scores are not cached since they depend on the window
+    auto side = (board_state->get_side_to_move() == white) ? 1 : -1;
+    if ((side * final_score - lazy_margin >= beta) || (side * final_score + lazy_margin <= alpha))
+    {
+        lazy_exits++;
+        return side * final_score;
+    }
+    full_evaluations++;
+    psqt_score += evaluate_activity(board_state);
+    final_score = taper(psqt_score, phase);
+    final_score += evaluate_pawn_structure(board_state) + evaluate_king_shield(board_state);
+    //Consider returning + for white and - for black at all times
+    auto score = side * final_score;
+    EvalCache::store(key, score);
+    return score;
+}
+
+void BasicEval::set_lazy_margin(int margin)
+{
+    lazy_margin = std::clamp(margin, MINIMUM_LAZY_MARGIN, MAXIMUM_LAZY_MARGIN);
+}
+
+long long BasicEval::get_lazy_exits()
+{
+    return lazy_exits;
+}
+
+long long BasicEval::get_full_evaluations()
 {
-    auto position_score = 0;
-    auto material_score = 0;
-    auto bitmap = bitboard{};
-    auto piece = 0;
-    auto square = 0;
-    for (int bb_piece = P; bb_piece <= k; bb_piece++)
+    return full_evaluations;
+}
+
+void BasicEval::reset_lazy_counters()
+{
+    lazy_exits = 0;
+    full_evaluations = 0;
+}
+
+constexpr int BOARD_WIDTH = 8;
+constexpr int BOARD_SQUARES = 64;
+constexpr int NUMBER_OF_SIDES = 2;
+constexpr int LAST_ROW = 7;
+constexpr int ROW_SHIFT = 8;
+
+//Pawn structure masks, rows count down the board from rank 8 so white pawns move to lower rows
+struct PawnMasks
+{
+    bitboard files[BOARD_WIDTH] = {};
+    bitboard adjacent_files[BOARD_WIDTH] = {};
+    //Squares ahead on the same and adjacent files, a pawn is passed when no enemy pawn is on them
+    bitboard passed[NUMBER_OF_SIDES][BOARD_SQUARES] = {};
+    //Squares level with or behind on the adjacent files, pawns there can still support the pawn
+    bitboard support[NUMBER_OF_SIDES][BOARD_SQUARES] = {};
+};
+
+constexpr PawnMasks generate_pawn_masks()
+{
+    auto masks = PawnMasks{};
+    for (auto square = 0; square < BOARD_SQUARES; square++)
+        masks.files[square % BOARD_WIDTH] |= 1ull << square;
+    for (auto file = 0; file < BOARD_WIDTH; file++)
+        masks.adjacent_files[file] = ((file > 0) ? masks.files[file - 1] : 0ull) |
+                                     ((file < BOARD_WIDTH - 1) ? masks.files[file + 1] : 0ull);
+    for (auto square = 0; square < BOARD_SQUARES; square++)
     {
-        bitmap = board_state->get_piece_bitboards()[bb_piece];
-        while (bitmap)
+        auto file = square % BOARD_WIDTH;
+        auto row = square / BOARD_WIDTH;
+        auto pawn_files = masks.files[file] | masks.adjacent_files[file];
+        for (auto other = 0; other < BOARD_SQUARES; other++)
         {
-            piece = bb_piece;
-            square = Bitboard::get_lsb_index(bitmap);
-            material_score += material_scores[piece];
-
-            switch (piece)
-            {
-                //White pieces
-                case (P): position_score += pawn_scores[square]; break;
-                case (N): position_score += knight_scores[square]; break;
-                case (B): position_score += bishop_scores[square]; break;
-                case (R): position_score += rook_scores[square]; break;
-                case (Q): break;
-                case (K): position_score += king_scores[square]; break;
-                //Black pieces
-                case (p): position_score -= pawn_scores[mirror_scores[square]]; break;
-                case (n): position_score -= knight_scores[mirror_scores[square]]; break;
-                case (b): position_score -= bishop_scores[mirror_scores[square]]; break;
-                case (r): position_score -= rook_scores[mirror_scores[square]]; break;
-                case (q): break;
-                case (k): position_score -= king_scores[mirror_scores[square]]; break;
-                default: break;
-            }
-
-            Bitboard::pop_bit(bitmap,square);
+            auto other_row = other / BOARD_WIDTH;
+            auto bit = 1ull << other;
+            if ((pawn_files & bit) && (other_row < row)) masks.passed[white][square] |= bit;
+            if ((pawn_files & bit) && (other_row > row)) masks.passed[black][square] |= bit;
+            if ((masks.adjacent_files[file] & bit) && (other_row >= row)) masks.support[white][square] |= bit;
+            if ((masks.adjacent_files[file] & bit) && (other_row <= row)) masks.support[black][square] |= bit;
         }
     }
-    auto final_score = position_score + material_score;
-    //Consider returning + for white and - for black at all times
-    return (board_state->get_side_to_move() == white) ? final_score : -final_score;
+    return masks;
+}
+
+constexpr PawnMasks pawn_masks = generate_pawn_masks();
+
+//Pawn structure of one side from that side's point of view
+static int evaluate_side_pawns(bitboard own_pawns, bitboard enemy_pawns, int side)
+{
+    auto score = 0;
+    for (auto file = 0; file < BOARD_WIDTH; file++)
+    {
+        auto pawns_on_file = Bitboard::count_bits(own_pawns & pawn_masks.files[file]);
+        if (pawns_on_file > 1)
+            score += BasicEval::DOUBLED_PAWN_PENALTY * (pawns_on_file - 1);
+    }
+    auto pawns = own_pawns;
+    while (pawns)
+    {
+        auto square = Bitboard::get_lsb_index(pawns);
+        Bitboard::pop_bit(pawns, square);
+        auto file = square % BOARD_WIDTH;
+        auto row = square / BOARD_WIDTH;
+        if (!(own_pawns & pawn_masks.adjacent_files[file]))
+            score += BasicEval::ISOLATED_PAWN_PENALTY;
+        else if (!(own_pawns & pawn_masks.support[side][square]))
+        {
+            //Unsupported and cannot advance without being taken by a pawn
+            auto stop_square = (side == white) ? square - ROW_SHIFT : square + ROW_SHIFT;
+            if (PawnAttacks::pawn_attacks[side][stop_square] & enemy_pawns)
+                score += BasicEval::BACKWARD_PAWN_PENALTY;
+        }
+        if (!(enemy_pawns & pawn_masks.passed[side][square]))
+            score += BasicEval::passed_pawn_scores[(side == white) ? LAST_ROW - row : row];
+    }
+    return score;
+}
+
+int BasicEval::evaluate_pawn_structure(std::shared_ptr<Boardstate> board_state)
+{
+    auto score = 0;
+    auto key = board_state->get_pawn_hash_key();
+    if (PawnTable::probe(key, score))
+        return score;
+    auto white_pawns = board_state->get_piece_bitboards()[P];
+    auto black_pawns = board_state->get_piece_bitboards()[p];
+    score = evaluate_side_pawns(white_pawns, black_pawns, white) -
+            evaluate_side_pawns(black_pawns, white_pawns, black);
+    PawnTable::store(key, score);
+    return score;
+}
+
+//Shield of one king from that side's point of view
+static int evaluate_side_shield(bitboard king, bitboard own_pawns, int side)
+{
+    auto square = Bitboard::get_lsb_index(king);
+    auto back_row = (side == white) ? LAST_ROW : 0;
+    if (square / BOARD_WIDTH != back_row)
+        return 0;
+    auto file = square % BOARD_WIDTH;
+    auto shield_files = pawn_masks.files[file] | pawn_masks.adjacent_files[file];
+    auto close_row = (side == white) ? back_row - 1 : back_row + 1;
+    auto far_row = (side == white) ? back_row - 2 : back_row + 2;
+    auto close_rank = 0xFFull << (close_row * BOARD_WIDTH);
+    auto far_rank = 0xFFull << (far_row * BOARD_WIDTH);
+    return BasicEval::CLOSE_SHIELD_PAWN_SCORE * Bitboard::count_bits(own_pawns & shield_files & close_rank) +
+           BasicEval::FAR_SHIELD_PAWN_SCORE * Bitboard::count_bits(own_pawns & shield_files & far_rank);
+}
+
+int BasicEval::evaluate_king_shield(std::shared_ptr<Boardstate> board_state)
+{
+    auto pieces = board_state->get_piece_bitboards();
+    auto score = 0;
+    if (pieces[q])
+        score += evaluate_side_shield(pieces[K], pieces[P], white);
+    if (pieces[Q])
+        score -= evaluate_side_shield(pieces[k], pieces[p], black);
+    return score;
+}
+
+constexpr int BLACK_PIECE_OFFSET = 6;
+
+BasicEval::Score BasicEval::evaluate_activity(std::shared_ptr<Boardstate> board_state)
+{
+    auto pieces = board_state->get_piece_bitboards();
+    auto white_king_zone = KingAttacks::king_attacks[Bitboard::get_lsb_index(pieces[K])] | pieces[K];
+    auto black_king_zone = KingAttacks::king_attacks[Bitboard::get_lsb_index(pieces[k])] | pieces[k];
+    auto score = Score{};
+    for (int piece = N; piece <= Q; piece++)
+    {
+        auto black_piece = piece + BLACK_PIECE_OFFSET;
+        score += mobility_scores[piece] *
+                 (board_state->get_piece_mobility(piece) - board_state->get_piece_mobility(black_piece));
+        score += king_zone_attack_scores[piece] *
+                 (Bitboard::count_bits(board_state->get_piece_attacks(black_piece) & white_king_zone) -
+                  Bitboard::count_bits(board_state->get_piece_attacks(piece) & black_king_zone));
+    }
+    return score;
 }
 
 #include "../Search/Search.h"
 constexpr int PV_BASE_SCORE = 20000;
+constexpr int HASH_MOVE_SCORE = 15000;
 constexpr int CAPTURE_MOVE_BASE_SCORE = 10000;
 constexpr int FIRST_KILLER_MOVE_SCORE = 9000;
 constexpr int SECOND_KILLER_MOVE_SCORE = 8000;
+constexpr int COUNTER_MOVE_SCORE = 7000;
+//Captures that lose material are tried after every quiet move
+constexpr int LOSING_CAPTURE_BASE_SCORE = -10000;
+constexpr int SEE_ORDERING_THRESHOLD = 0;
 constexpr int FIRST_KILLER_MOVE_INDEX = 0;
 constexpr int SECOND_KILLER_MOVE_INDEX = 1;
 
@@ -61,34 +226,32 @@ int BasicEval::score_move(std::shared_ptr<Boardstate> board_state, Move move)
             return PV_BASE_SCORE;
         }
     }
+    //Score the best move from the transposition table next
+    if (NegaMax::hash_moves[NegaMax::get_ply()] == move)
+        return HASH_MOVE_SCORE;
     //For capture move scoring
     if (move.get_move_capture_flag())
     {
-        //Init target piece as pawn in event of en-passant capture
-        int target_piece = P;
-        //Determine side to move
-        int start_piece = 0, end_piece = 0;
-        if (board_state->get_side_to_move() == white) {start_piece = p; end_piece = k;}
-        else {start_piece = P; end_piece = K;}
-        //Loop over bitboards to determine target piece
-        for (auto bb_piece = start_piece; bb_piece <= end_piece; bb_piece++)
-        {
-            if (Bitboard::get_bit(board_state->get_piece_bitboards()[bb_piece], move.get_move_target_square()))
-            {
-                target_piece = bb_piece;
-            }
-        }
-        return mvv_lva[move.get_move_piece()][target_piece] + CAPTURE_MOVE_BASE_SCORE;
+        //En passant targets are empty, the captured piece is a pawn
+        int target_piece = board_state->get_piece_on_square(move.get_move_target_square());
+        if (move.get_move_en_passant_flag())
+            target_piece = P;
+        //Split winning and equal captures from those losing the exchange
+        if (board_state->see(move, SEE_ORDERING_THRESHOLD))
+            return mvv_lva[move.get_move_piece()][target_piece] + CAPTURE_MOVE_BASE_SCORE;
+        return mvv_lva[move.get_move_piece()][target_piece] + LOSING_CAPTURE_BASE_SCORE;
     }
     else
     //For Quiet move scoring
     {
-        if (NegaMax::killer_moves[FIRST_KILLER_MOVE_INDEX][NegaMax::get_ply()] == move)
+        if (NegaMax::search_stack[NegaMax::get_ply()].killers[FIRST_KILLER_MOVE_INDEX] == move)
             return FIRST_KILLER_MOVE_SCORE;
-        else if (NegaMax::killer_moves[SECOND_KILLER_MOVE_INDEX][NegaMax::get_ply()] == move)
+        else if (NegaMax::search_stack[NegaMax::get_ply()].killers[SECOND_KILLER_MOVE_INDEX] == move)
             return SECOND_KILLER_MOVE_SCORE;
+        else if (NegaMax::get_counter_move() == move)
+            return COUNTER_MOVE_SCORE;
         else
-            return NegaMax::history_moves[move.get_move_piece()][move.get_move_target_square()];
+            return NegaMax::get_quiet_history(move);
     }
     return 0;
 }
@@ -8,6 +8,7 @@
 #include "../BitBoard.h"
 #include "../BoardState.h"
 #include "../Move.h"
+#include "PSQT.h"
 
 
 /** \file BasicEval.h
@@ -32,89 +33,50 @@ namespace BasicEval
         -1000,  //Black Queen
         -10000  //Black King
     };
-    constexpr int NUMBER_OF_SQUARES = 64;
-    constexpr int DOUBLE_NUMBER_OF_SQUARES = 64;
-    // pawn positional score
-    inline constexpr int pawn_scores[NUMBER_OF_SQUARES] =
+    //Pawn structure penalties and bonuses
+    constexpr int DOUBLED_PAWN_PENALTY = -10;
+    constexpr int ISOLATED_PAWN_PENALTY = -10;
+    constexpr int BACKWARD_PAWN_PENALTY = -8;
+    constexpr int NUMBER_OF_RANKS = 8;
+    //Passed pawn bonus indexed by rank from the pawn's own side, i.e. a white pawn on e7 is rank 6
+    inline constexpr int passed_pawn_scores[NUMBER_OF_RANKS] = {0, 5, 10, 20, 35, 60, 100, 0};
+    //Bonus for each pawn in front of a king on its back rank, one and two ranks ahead
+    constexpr int CLOSE_SHIELD_PAWN_SCORE = 10;
+    constexpr int FAR_SHIELD_PAWN_SCORE = 5;
+    //Bonus per safe square attacked, see AttackMap::mobility, indexed by white piece
+    inline constexpr Score mobility_scores[PSQT_PIECE_TYPES] =
     {
-        90,  90,  90,  90,  90,  90,  90,  90,
-        30,  30,  30,  40,  40,  30,  30,  30,
-        20,  20,  20,  30,  30,  30,  20,  20,
-        10,  10,  10,  20,  20,  10,  10,  10,
-         5,   5,  10,  20,  20,   5,   5,   5,
-         0,   0,   0,   5,   5,   0,   0,   0,
-         0,   0,   0, -10, -10,   0,   0,   0,
-         0,   0,   0,   0,   0,   0,   0,   0
+        S(0, 0), S(4, 4), S(4, 5), S(2, 4), S(1, 2), S(0, 0)
     };
-
-    // knight positional score
-    inline constexpr int knight_scores[NUMBER_OF_SQUARES] =
-    {
-        -5,   0,   0,   0,   0,   0,   0,  -5,
-        -5,   0,   0,  10,  10,   0,   0,  -5,
-        -5,   5,  20,  20,  20,  20,   5,  -5,
-        -5,  10,  20,  30,  30,  20,  10,  -5,
-        -5,  10,  20,  30,  30,  20,  10,  -5,
-        -5,   5,  20,  10,  10,  20,   5,  -5,
-        -5,   0,   0,   0,   0,   0,   0,  -5,
-        -5, -10,   0,   0,   0,   0, -10,  -5
-    };
-
-    // bishop positional score
-    inline constexpr int bishop_scores[NUMBER_OF_SQUARES] =
-    {
-         0,   0,   0,   0,   0,   0,   0,   0,
-         0,   0,   0,   0,   0,   0,   0,   0,
-         0,   0,   0,  10,  10,   0,   0,   0,
-         0,   0,  10,  20,  20,  10,   0,   0,
-         0,   0,  10,  20,  20,  10,   0,   0,
-         0,  10,   0,   0,   0,   0,  10,   0,
-         0,  30,   0,   0,   0,   0,  30,   0,
-         0,   0, -10,   0,   0, -10,   0,   0
-
-    };
-
-    // rook positional score
-    inline constexpr int rook_scores[NUMBER_OF_SQUARES] =
+    //Penalty per square around a king attacked by an enemy piece type, fades out with the queens
+    inline constexpr Score king_zone_attack_scores[PSQT_PIECE_TYPES] =
     {
-        50,  50,  50,  50,  50,  50,  50,  50,
-        50,  50,  50,  50,  50,  50,  50,  50,
-         0,   0,  10,  20,  20,  10,   0,   0,
-         0,   0,  10,  20,  20,  10,   0,   0,
-         0,   0,  10,  20,  20,  10,   0,   0,
-         0,   0,  10,  20,  20,  10,   0,   0,
-         0,   0,  10,  20,  20,  10,   0,   0,
-         0,   0,   0,  20,  20,   0,   0,   0
-
+        S(0, 0), S(-8, 0), S(-8, 0), S(-10, 0), S(-15, 0), S(0, 0)
     };
 
-    // king positional score
-    inline constexpr int king_scores[NUMBER_OF_SQUARES] =
-    {
-         0,   0,   0,   0,   0,   0,   0,   0,
-         0,   0,   5,   5,   5,   5,   0,   0,
-         0,   5,   5,  10,  10,   5,   5,   0,
-         0,   5,  10,  20,  20,  10,   5,   0,
-         0,   5,  10,  20,  20,  10,   5,   0,
-         0,   0,   5,  10,  10,   5,   0,   0,
-         0,   5,   5,  -5,  -5,   0,   5,   0,
-         0,   0,   5,   0, -15,   0,  10,   0
-    };
-
-    // mirror positional score tables for opposite side
-    inline constexpr int mirror_scores[DOUBLE_NUMBER_OF_SQUARES] =
-    {
-        a1, b1, c1, d1, e1, f1, g1, h1,
-        a2, b2, c2, d2, e2, f2, g2, h2,
-        a3, b3, c3, d3, e3, f3, g3, h3,
-        a4, b4, c4, d4, e4, f4, g4, h4,
-        a5, b5, c5, d5, e5, f5, g5, h5,
-        a6, b6, c6, d6, e6, f6, g6, h6,
-        a7, b7, c7, d7, e7, f7, g7, h7,
-        a8, b8, c8, d8, e8, f8, g8, h8
-    };
-    //Evaluate a position
-    int evaluate(std::shared_ptr<Boardstate> board_state);
+    //Lazy evaluation skips the pawn and king terms once the material and piece square
+    //score is further than the margin outside the search window
+    constexpr int DEFAULT_LAZY_MARGIN = 400;
+    constexpr int MINIMUM_LAZY_MARGIN = 0;
+    constexpr int MAXIMUM_LAZY_MARGIN = 2000;
+    constexpr int NO_WINDOW_BOUND = 1000000;
+
+    //Evaluate a position, the material and piece square terms are tapered between
+    //midgame and endgame by the game phase Boardstate keeps. Scores outside (alpha, beta)
+    //may be returned lazily and are then only accurate to within the margin.
+    int evaluate(std::shared_ptr<Boardstate> board_state, int alpha = -NO_WINDOW_BOUND,
+                 int beta = NO_WINDOW_BOUND);
+    void set_lazy_margin(int margin);
+    //How often the expensive terms were skipped, reset with reset_lazy_counters()
+    long long get_lazy_exits();
+    long long get_full_evaluations();
+    void reset_lazy_counters();
+    //Doubled, isolated, backward and passed pawns from white's point of view, cached in the PawnTable
+    int evaluate_pawn_structure(std::shared_ptr<Boardstate> board_state);
+    //Pawn shield of both kings from white's point of view, only while the opponent has a queen
+    int evaluate_king_shield(std::shared_ptr<Boardstate> board_state);
+    //Mobility and king zone attacks from white's point of view, read from the board's attack maps
+    Score evaluate_activity(std::shared_ptr<Boardstate> board_state);
 
     //Score a move from a movelist to enable Move ordering and reduction of Alpha Beta search
     int score_move(std::shared_ptr<Boardstate> board_state, Move move);
@@ -0,0 +1,150 @@
+#include "BatchEval.h"
+
+#include <thread>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+//Rows of 64 squares, pieces use rows 0 to 11 and NO_PIECE masked to 4 bits lands on an empty row
+constexpr int TABLE_ROWS = 16;
+constexpr int PIECE_MASK = TABLE_ROWS - 1;
+constexpr int ROW_SHIFT = 6;
+
+struct BatchTables
+{
+    BasicEval::Score scores[TABLE_ROWS * BasicEval::PSQT_SQUARES] = {};
+    int phases[TABLE_ROWS * BasicEval::PSQT_SQUARES] = {};
+    //Phase weight of each piece enum, twice over to fill both lanes of a byte shuffle
+    int8_t phase_bytes[2 * TABLE_ROWS] = {};
+};
+
+constexpr BatchTables generate_batch_tables()
+{
+    auto tables = BatchTables{};
+    for (auto piece = 0; piece < BasicEval::PSQT_PIECES; piece++)
+    {
+        for (auto square = 0; square < BasicEval::PSQT_SQUARES; square++)
+        {
+            tables.scores[(piece << ROW_SHIFT) + square] = BasicEval::psqt.scores[piece][square];
+            tables.phases[(piece << ROW_SHIFT) + square] = BasicEval::phase_weights[piece];
+        }
+        tables.phase_bytes[piece] = static_cast<int8_t>(BasicEval::phase_weights[piece]);
+        tables.phase_bytes[piece + TABLE_ROWS] = static_cast<int8_t>(BasicEval::phase_weights[piece]);
+    }
+    return tables;
+}
+
+alignas(32) static constexpr BatchTables batch_tables = generate_batch_tables();
+
+BatchEval::CompactPosition BatchEval::compact(std::shared_ptr<Boardstate> board_state)
+{
+    auto position = CompactPosition{};
+    for (auto square = 0; square < BasicEval::PSQT_SQUARES; square++)
+        position.pieces[square] = static_cast<int8_t>(board_state->get_piece_on_square(square));
+    position.side_to_move = static_cast<int8_t>(board_state->get_side_to_move());
+    return position;
+}
+
+static inline int side_relative(const BatchEval::CompactPosition &position, BasicEval::Score score, int phase)
+{
+    auto white_score = BasicEval::taper(score, phase);
+    return (position.side_to_move == white) ? white_score : -white_score;
+}
+
+void BatchEval::evaluate_scalar(const CompactPosition *positions, int count, int *scores)
+{
+    for (auto i = 0; i < count; i++)
+    {
+        auto score = BasicEval::Score{};
+        auto phase = 0;
+        for (auto square = 0; square < BasicEval::PSQT_SQUARES; square++)
+        {
+            auto index = ((positions[i].pieces[square] & PIECE_MASK) << ROW_SHIFT) + square;
+            score += batch_tables.scores[index];
+            phase += batch_tables.phases[index];
+        }
+        scores[i] = side_relative(positions[i], score, phase);
+    }
+}
+
+#if defined(__AVX2__)
+constexpr int SQUARES_PER_GATHER = 8;
+constexpr int POSITIONS_PER_ITERATION = 2;
+
+static inline int horizontal_sum(__m256i values)
+{
+    auto half = _mm_add_epi32(_mm256_castsi256_si128(values), _mm256_extracti128_si256(values, 1));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(half);
+}
+
+//Table indices of eight squares starting at the given one
+static inline __m256i gather_indices(const BatchEval::CompactPosition &position, int square)
+{
+    auto bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(position.pieces + square));
+    auto pieces = _mm256_and_si256(_mm256_cvtepi8_epi32(bytes), _mm256_set1_epi32(PIECE_MASK));
+    auto squares = _mm256_add_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(square));
+    return _mm256_add_epi32(_mm256_slli_epi32(pieces, ROW_SHIFT), squares);
+}
+
+//Phase weights of all 64 squares through a byte shuffle, summed with sum of absolute differences
+static inline int simd_phase(const BatchEval::CompactPosition &position)
+{
+    auto weights = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(batch_tables.phase_bytes));
+    auto mask = _mm256_set1_epi8(PIECE_MASK);
+    auto low = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(position.pieces)), mask);
+    auto high = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(position.pieces + 32)), mask);
+    auto sums = _mm256_sad_epu8(_mm256_add_epi8(_mm256_shuffle_epi8(weights, low), _mm256_shuffle_epi8(weights, high)),
+                                _mm256_setzero_si256());
+    return horizontal_sum(sums);
+}
+
+//Two positions per iteration keep independent gathers in flight
+static void evaluate_simd(const BatchEval::CompactPosition *positions, int count, int *scores)
+{
+    auto i = 0;
+    for (; i + POSITIONS_PER_ITERATION <= count; i += POSITIONS_PER_ITERATION)
+    {
+        auto first_scores = _mm256_setzero_si256();
+        auto second_scores = _mm256_setzero_si256();
+        for (auto square = 0; square < BasicEval::PSQT_SQUARES; square += SQUARES_PER_GATHER)
+        {
+            first_scores = _mm256_add_epi32(first_scores, _mm256_i32gather_epi32(batch_tables.scores,
+                                            gather_indices(positions[i], square), 4));
+            second_scores = _mm256_add_epi32(second_scores, _mm256_i32gather_epi32(batch_tables.scores,
+                                             gather_indices(positions[i + 1], square), 4));
+        }
+        //Packed scores add lane by lane, so the sum of the lanes is the packed total
+        scores[i] = side_relative(positions[i], horizontal_sum(first_scores), simd_phase(positions[i]));
+        scores[i + 1] = side_relative(positions[i + 1], horizontal_sum(second_scores), simd_phase(positions[i + 1]));
+    }
+    BatchEval::evaluate_scalar(positions + i, count - i, scores + i);
+}
+#else
+static void evaluate_simd(const BatchEval::CompactPosition *positions, int count, int *scores)
+{
+    BatchEval::evaluate_scalar(positions, count, scores);
+}
+#endif
+
+void BatchEval::evaluate(const CompactPosition *positions, int count, int *scores, int threads)
+{
+    if ((threads <= 1) || (count < threads))
+    {
+        evaluate_simd(positions, count, scores);
+        return;
+    }
+    //Contiguous slices so each thread streams through its own part of the arrays
+    std::vector<std::thread> workers;
+    auto slice = (count + threads - 1) / threads;
+    for (auto start = 0; start < count; start += slice)
+    {
+        auto size = std::min(slice, count - start);
+        workers.emplace_back(evaluate_simd, positions + start, size, scores + start);
+    }
+    for (auto &worker : workers)
+        worker.join();
+}
@@ -0,0 +1,37 @@
+#ifndef BATCHEVAL_H
+#define BATCHEVAL_H
+
+#include <memory>
+#include <cstdint>
+
+#include "../BoardState.h"
+#include "PSQT.h"
+
+/** \file BatchEval.h
+    \brief Contains evaluation of many positions at once
+ */
+
+//Evaluates large sets of positions, e.g. for training or analysis, without a Boardstate
+//per position. The score is the tapered material and piece square part of
+//BasicEval::evaluate, the part Boardstate keeps incrementally during search.
+namespace BatchEval
+{
+    constexpr int8_t NO_PIECE = -1;
+
+    //One byte per square holding the piece enum or NO_PIECE, a8 first
+    class CompactPosition
+    {
+    public:
+        int8_t pieces[BasicEval::PSQT_SQUARES] = {};
+        int8_t side_to_move = white;
+    };
+
+    CompactPosition compact(std::shared_ptr<Boardstate> board_state);
+    //Scores from the side to move's point of view, the batch is split across the given
+    //number of threads. Uses AVX2 gathers where available and the scalar path otherwise.
+    void evaluate(const CompactPosition *positions, int count, int *scores, int threads = 1);
+    //Reference path, one table lookup per square
+    void evaluate_scalar(const CompactPosition *positions, int count, int *scores);
+}
+
+#endif
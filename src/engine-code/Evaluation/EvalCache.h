@@ -0,0 +1,18 @@
+#ifndef EVALCACHE_H
+#define EVALCACHE_H
+
+#include "ScoreTable.h"
+
+/** \file EvalCache.h
+    \brief Contains the evaluation cache
+ */
+
+//Cache of static evaluations keyed by the position hash, transpositions in capture
+//sequences reach the same positions often. Scores are from the side to move's point of view.
+class EvalCache : public ScoreTable<EvalCache>
+{
+public:
+    static constexpr int DEFAULT_SIZE_MB = 4;
+};
+
+#endif
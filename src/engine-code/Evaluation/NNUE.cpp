@@ -0,0 +1,214 @@
+#include "NNUE.h"
+
+#include <fstream>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+constexpr int NUM_SQUARES = 64;
+constexpr int COLOR_PIECE_SHIFT = 6;
+constexpr int NUM_PIECE_TYPES = 12;
+constexpr int FLIP_RANKS = 56;
+
+alignas(32) static int16_t input_weights[NNUE_INPUT_SIZE][NNUE_HIDDEN_SIZE];
+alignas(32) static int16_t input_biases[NNUE_HIDDEN_SIZE];
+alignas(32) static int16_t output_weights[NNUE_PERSPECTIVES * NNUE_HIDDEN_SIZE];
+static int16_t output_bias;
+
+bool NNUE::loaded_{false};
+bool NNUE::enabled_{false};
+
+//Black sees the board with the colours swapped and the ranks mirrored
+static inline int perspective_input(int input, int perspective)
+{
+    if (perspective == white)
+        return input;
+    auto piece = input / NUM_SQUARES;
+    auto square = input % NUM_SQUARES;
+    return ((piece + COLOR_PIECE_SHIFT) % NUM_PIECE_TYPES) * NUM_SQUARES + (square ^ FLIP_RANKS);
+}
+
+//Vector kernels, each has a scalar version for targets without SSE2
+static inline void add_weights(int16_t *values, const int16_t *weights)
+{
+#if defined(__AVX2__)
+    for (int i = 0; i < NNUE_HIDDEN_SIZE; i += 16)
+    {
+        auto sum = _mm256_add_epi16(_mm256_load_si256((const __m256i*)(values + i)),
+                                    _mm256_load_si256((const __m256i*)(weights + i)));
+        _mm256_store_si256((__m256i*)(values + i), sum);
+    }
+#elif defined(__SSE2__)
+    for (int i = 0; i < NNUE_HIDDEN_SIZE; i += 8)
+    {
+        auto sum = _mm_add_epi16(_mm_load_si128((const __m128i*)(values + i)),
+                                 _mm_load_si128((const __m128i*)(weights + i)));
+        _mm_store_si128((__m128i*)(values + i), sum);
+    }
+#else
+    for (int i = 0; i < NNUE_HIDDEN_SIZE; i++)
+        values[i] += weights[i];
+#endif
+}
+
+static inline void subtract_weights(int16_t *values, const int16_t *weights)
+{
+#if defined(__AVX2__)
+    for (int i = 0; i < NNUE_HIDDEN_SIZE; i += 16)
+    {
+        auto difference = _mm256_sub_epi16(_mm256_load_si256((const __m256i*)(values + i)),
+                                           _mm256_load_si256((const __m256i*)(weights + i)));
+        _mm256_store_si256((__m256i*)(values + i), difference);
+    }
+#elif defined(__SSE2__)
+    for (int i = 0; i < NNUE_HIDDEN_SIZE; i += 8)
+    {
+        auto difference = _mm_sub_epi16(_mm_load_si128((const __m128i*)(values + i)),
+                                        _mm_load_si128((const __m128i*)(weights + i)));
+        _mm_store_si128((__m128i*)(values + i), difference);
+    }
+#else
+    for (int i = 0; i < NNUE_HIDDEN_SIZE; i++)
+        values[i] -= weights[i];
+#endif
+}
+
+//Dot product of the accumulator clipped to [0, QA] with the output weights
+static inline int clipped_dot(const int16_t *values, const int16_t *weights)
+{
+#if defined(__AVX2__)
+    auto zero = _mm256_setzero_si256();
+    auto ceiling = _mm256_set1_epi16(NNUE::QA);
+    auto sum = _mm256_setzero_si256();
+    for (int i = 0; i < NNUE_HIDDEN_SIZE; i += 16)
+    {
+        auto clipped = _mm256_min_epi16(_mm256_max_epi16(_mm256_load_si256((const __m256i*)(values + i)), zero),
+                                        ceiling);
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(clipped, _mm256_load_si256((const __m256i*)(weights + i))));
+    }
+    auto half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(half);
+#elif defined(__SSE2__)
+    auto zero = _mm_setzero_si128();
+    auto ceiling = _mm_set1_epi16(NNUE::QA);
+    auto sum = _mm_setzero_si128();
+    for (int i = 0; i < NNUE_HIDDEN_SIZE; i += 8)
+    {
+        auto clipped = _mm_min_epi16(_mm_max_epi16(_mm_load_si128((const __m128i*)(values + i)), zero), ceiling);
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(clipped, _mm_load_si128((const __m128i*)(weights + i))));
+    }
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(sum);
+#else
+    auto sum = 0;
+    for (int i = 0; i < NNUE_HIDDEN_SIZE; i++)
+        sum += std::clamp(static_cast<int>(values[i]), 0, NNUE::QA) * weights[i];
+    return sum;
+#endif
+}
+
+bool NNUE::load(const std::string &file_name)
+{
+    std::ifstream file(file_name, std::ios::binary | std::ios::ate);
+    if (!file)
+        return false;
+    constexpr auto NUM_WEIGHTS = NNUE_INPUT_SIZE * NNUE_HIDDEN_SIZE + NNUE_HIDDEN_SIZE +
+                                 NNUE_PERSPECTIVES * NNUE_HIDDEN_SIZE + 1;
+    if (file.tellg() != static_cast<std::streamoff>(NUM_WEIGHTS * sizeof(int16_t)))
+        return false;
+    file.seekg(0);
+    std::vector<int16_t> weights(NUM_WEIGHTS);
+    if (!file.read(reinterpret_cast<char*>(weights.data()), NUM_WEIGHTS * sizeof(int16_t)))
+        return false;
+    auto next = weights.data();
+    memcpy(input_weights, next, sizeof(input_weights));
+    next += NNUE_INPUT_SIZE * NNUE_HIDDEN_SIZE;
+    memcpy(input_biases, next, sizeof(input_biases));
+    next += NNUE_HIDDEN_SIZE;
+    memcpy(output_weights, next, sizeof(output_weights));
+    next += NNUE_PERSPECTIVES * NNUE_HIDDEN_SIZE;
+    output_bias = *next;
+    loaded_ = true;
+    return true;
+}
+
+bool NNUE::is_loaded()
+{
+    return loaded_;
+}
+
+void NNUE::set_enabled(bool enabled)
+{
+    enabled_ = enabled;
+}
+
+int NNUE::evaluate(std::shared_ptr<Boardstate> board_state)
+{
+    update_accumulator(board_state);
+    auto &accumulator = board_state->get_accumulators()[board_state->get_accumulator_index()];
+    auto side = board_state->get_side_to_move();
+    auto sum = clipped_dot(accumulator.values[side], output_weights) +
+               clipped_dot(accumulator.values[side ^ 1], output_weights + NNUE_HIDDEN_SIZE);
+    return static_cast<int>((static_cast<long long>(sum) + output_bias) * EVAL_SCALE / (QA * QB));
+}
+
+void NNUE::update_accumulator(std::shared_ptr<Boardstate> board_state)
+{
+    auto accumulators = board_state->get_accumulators();
+    auto index = board_state->get_accumulator_index();
+    if (accumulators[index].computed)
+        return;
+    auto start = index;
+    while ((start > 0) && !accumulators[start].computed)
+        start--;
+    //No computed ancestor since the stack was reset
+    if (!accumulators[start].computed)
+    {
+        refresh_accumulator(board_state, accumulators[index]);
+        return;
+    }
+    for (auto ply = start + 1; ply <= index; ply++)
+        apply_changes(accumulators[ply - 1], accumulators[ply]);
+}
+
+void NNUE::refresh_accumulator(std::shared_ptr<Boardstate> board_state, Accumulator &accumulator)
+{
+    for (int perspective = white; perspective <= black; perspective++)
+    {
+        memcpy(accumulator.values[perspective], input_biases, sizeof(input_biases));
+        for (int bb_piece = P; bb_piece <= k; bb_piece++)
+        {
+            auto bitmap = board_state->get_piece_bitboards()[bb_piece];
+            while (bitmap)
+            {
+                auto square = Bitboard::get_lsb_index(bitmap);
+                add_weights(accumulator.values[perspective],
+                            input_weights[perspective_input(bb_piece * NUM_SQUARES + square, perspective)]);
+                Bitboard::pop_bit(bitmap, square);
+            }
+        }
+    }
+    accumulator.computed = true;
+}
+
+void NNUE::apply_changes(const Accumulator &previous, Accumulator &accumulator)
+{
+    for (int perspective = white; perspective <= black; perspective++)
+    {
+        memcpy(accumulator.values[perspective], previous.values[perspective], sizeof(accumulator.values[perspective]));
+        for (int i = 0; i < accumulator.num_removed; i++)
+            subtract_weights(accumulator.values[perspective],
+                             input_weights[perspective_input(accumulator.removed[i], perspective)]);
+        for (int i = 0; i < accumulator.num_added; i++)
+            add_weights(accumulator.values[perspective],
+                        input_weights[perspective_input(accumulator.added[i], perspective)]);
+    }
+    accumulator.computed = true;
+}
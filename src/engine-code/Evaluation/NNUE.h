@@ -0,0 +1,50 @@
+#ifndef NNUE_H
+#define NNUE_H
+
+#include <memory>
+#include <string>
+
+#include "../BoardState.h"
+#include "Accumulator.h"
+
+/** \file NNUE.h
+    \brief Contains the efficiently updatable neural network evaluation
+ */
+
+//A 768->256x2->1 network. Each side's accumulator sums the first layer weights of the
+//pieces on the board seen from that side, the output layer takes the clipped accumulators
+//of the side to move and its opponent.
+//
+//The weights file is a raw little endian int16 dump in the order
+//  input weights [768][256], input biases [256], output weights [512], output bias
+//where input 64 * piece + square is the piece enum and the a8 = 0 square numbering.
+//Input values are scaled by QA and output weights by QB.
+class NNUE
+{
+public:
+    //Returns false and keeps the previous network if the file is missing or the wrong size
+    static bool load(const std::string &file_name);
+    static bool is_loaded();
+    //Evaluation is only switched to the network once weights are loaded
+    static void set_enabled(bool enabled);
+    //Inline as make_move checks it to skip the accumulator bookkeeping
+    static inline bool is_enabled()
+    {
+        return enabled_ && loaded_;
+    }
+    //Score from the side to move's point of view
+    static int evaluate(std::shared_ptr<Boardstate> board_state);
+    static constexpr auto DEFAULT_FILE = "omega.nnue";
+    static constexpr int QA = 255;
+    static constexpr int QB = 64;
+    static constexpr int EVAL_SCALE = 400;
+private:
+    //Brings the current accumulator up to date from the nearest computed one
+    static void update_accumulator(std::shared_ptr<Boardstate> board_state);
+    static void refresh_accumulator(std::shared_ptr<Boardstate> board_state, Accumulator &accumulator);
+    static void apply_changes(const Accumulator &previous, Accumulator &accumulator);
+    static bool loaded_;
+    static bool enabled_;
+};
+
+#endif
@@ -0,0 +1,241 @@
+#ifndef PSQT_H
+#define PSQT_H
+
+#include <cstdint>
+
+#include "../BitBoard.h"
+
+/** \file PSQT.h
+    \brief Contains the tapered piece square tables
+ */
+
+namespace BasicEval
+{
+    //A midgame and an endgame value packed into one integer, the endgame value in the
+    //upper 16 bits. Sums of packed scores add both halves with a single addition.
+    using Score = int;
+
+    constexpr Score S(int mg, int eg)
+    {
+        return static_cast<Score>(static_cast<unsigned int>(eg) << 16) + mg;
+    }
+
+    constexpr int mg_value(Score score)
+    {
+        return static_cast<int16_t>(static_cast<uint16_t>(static_cast<unsigned int>(score)));
+    }
+
+    //Rounds so that a negative midgame half borrowing from the upper bits is undone
+    constexpr int eg_value(Score score)
+    {
+        return static_cast<int16_t>(static_cast<uint16_t>((static_cast<unsigned int>(score) + 0x8000) >> 16));
+    }
+
+    constexpr int PSQT_PIECES = 12;
+    constexpr int PSQT_PIECE_TYPES = 6;
+    constexpr int PSQT_SQUARES = 64;
+
+    //Game phase counts down from MAX_GAME_PHASE as minor and major pieces come off.
+    //Promotions can push it past the maximum, evaluation caps it.
+    constexpr int MAX_GAME_PHASE = 24;
+    inline constexpr int phase_weights[PSQT_PIECES] = {0, 1, 1, 2, 4, 0, 0, 1, 1, 2, 4, 0};
+
+    //Blend the midgame and endgame halves, phase runs from 0 in the endgame to MAX_GAME_PHASE
+    constexpr int taper(Score score, int phase)
+    {
+        phase = (phase < MAX_GAME_PHASE) ? phase : MAX_GAME_PHASE;
+        return (mg_value(score) * phase + eg_value(score) * (MAX_GAME_PHASE - phase)) / MAX_GAME_PHASE;
+    }
+
+    //Piece values for the midgame and endgame, kings are never traded so they have none
+    inline constexpr int mg_piece_values[PSQT_PIECE_TYPES] = {100, 300, 350, 500, 1000, 0};
+    inline constexpr int eg_piece_values[PSQT_PIECE_TYPES] = {120, 290, 320, 540, 960, 0};
+
+    //Tables below are from white's point of view with a8 first, black mirrors the ranks
+    inline constexpr int mg_pawn_scores[PSQT_SQUARES] =
+    {
+        90,  90,  90,  90,  90,  90,  90,  90,
+        30,  30,  30,  40,  40,  30,  30,  30,
+        20,  20,  20,  30,  30,  30,  20,  20,
+        10,  10,  10,  20,  20,  10,  10,  10,
+         5,   5,  10,  20,  20,   5,   5,   5,
+         0,   0,   0,   5,   5,   0,   0,   0,
+         0,   0,   0, -10, -10,   0,   0,   0,
+         0,   0,   0,   0,   0,   0,   0,   0
+    };
+
+    //Pushing pawns matters more once the pieces are gone
+    inline constexpr int eg_pawn_scores[PSQT_SQUARES] =
+    {
+         0,   0,   0,   0,   0,   0,   0,   0,
+        80,  80,  80,  80,  80,  80,  80,  80,
+        50,  50,  50,  50,  50,  50,  50,  50,
+        30,  30,  30,  30,  30,  30,  30,  30,
+        15,  15,  15,  15,  15,  15,  15,  15,
+         5,   5,   5,   5,   5,   5,   5,   5,
+         0,   0,   0,   0,   0,   0,   0,   0,
+         0,   0,   0,   0,   0,   0,   0,   0
+    };
+
+    inline constexpr int mg_knight_scores[PSQT_SQUARES] =
+    {
+        -5,   0,   0,   0,   0,   0,   0,  -5,
+        -5,   0,   0,  10,  10,   0,   0,  -5,
+        -5,   5,  20,  20,  20,  20,   5,  -5,
+        -5,  10,  20,  30,  30,  20,  10,  -5,
+        -5,  10,  20,  30,  30,  20,  10,  -5,
+        -5,   5,  20,  10,  10,  20,   5,  -5,
+        -5,   0,   0,   0,   0,   0,   0,  -5,
+        -5, -10,   0,   0,   0,   0, -10,  -5
+    };
+
+    inline constexpr int eg_knight_scores[PSQT_SQUARES] =
+    {
+       -20, -10, -10, -10, -10, -10, -10, -20,
+       -10,   0,   0,   5,   5,   0,   0, -10,
+       -10,   5,  10,  15,  15,  10,   5, -10,
+       -10,   5,  15,  20,  20,  15,   5, -10,
+       -10,   5,  15,  20,  20,  15,   5, -10,
+       -10,   5,  10,  15,  15,  10,   5, -10,
+       -10,   0,   0,   5,   5,   0,   0, -10,
+       -20, -10, -10, -10, -10, -10, -10, -20
+    };
+
+    inline constexpr int mg_bishop_scores[PSQT_SQUARES] =
+    {
+         0,   0,   0,   0,   0,   0,   0,   0,
+         0,   0,   0,   0,   0,   0,   0,   0,
+         0,   0,   0,  10,  10,   0,   0,   0,
+         0,   0,  10,  20,  20,  10,   0,   0,
+         0,   0,  10,  20,  20,  10,   0,   0,
+         0,  10,   0,   0,   0,   0,  10,   0,
+         0,  30,   0,   0,   0,   0,  30,   0,
+         0,   0, -10,   0,   0, -10,   0,   0
+    };
+
+    inline constexpr int eg_bishop_scores[PSQT_SQUARES] =
+    {
+       -10,  -5,  -5,  -5,  -5,  -5,  -5, -10,
+        -5,   0,   0,   0,   0,   0,   0,  -5,
+        -5,   0,   5,  10,  10,   5,   0,  -5,
+        -5,   0,  10,  15,  15,  10,   0,  -5,
+        -5,   0,  10,  15,  15,  10,   0,  -5,
+        -5,   0,   5,  10,  10,   5,   0,  -5,
+        -5,   0,   0,   0,   0,   0,   0,  -5,
+       -10,  -5,  -5,  -5,  -5,  -5,  -5, -10
+    };
+
+    inline constexpr int mg_rook_scores[PSQT_SQUARES] =
+    {
+        50,  50,  50,  50,  50,  50,  50,  50,
+        50,  50,  50,  50,  50,  50,  50,  50,
+         0,   0,  10,  20,  20,  10,   0,   0,
+         0,   0,  10,  20,  20,  10,   0,   0,
+         0,   0,  10,  20,  20,  10,   0,   0,
+         0,   0,  10,  20,  20,  10,   0,   0,
+         0,   0,  10,  20,  20,  10,   0,   0,
+         0,   0,   0,  20,  20,   0,   0,   0
+    };
+
+    inline constexpr int eg_rook_scores[PSQT_SQUARES] =
+    {
+        10,  10,  10,  10,  10,  10,  10,  10,
+        20,  20,  20,  20,  20,  20,  20,  20,
+         5,   5,   5,   5,   5,   5,   5,   5,
+         0,   0,   0,   0,   0,   0,   0,   0,
+         0,   0,   0,   0,   0,   0,   0,   0,
+         0,   0,   0,   0,   0,   0,   0,   0,
+         0,   0,   0,   0,   0,   0,   0,   0,
+         0,   0,   0,   0,   0,   0,   0,   0
+    };
+
+    //Early queen sorties to the rim are discouraged
+    inline constexpr int mg_queen_scores[PSQT_SQUARES] =
+    {
+       -20, -10, -10,  -5,  -5, -10, -10, -20,
+       -10,   0,   0,   0,   0,   0,   0, -10,
+       -10,   0,   5,   5,   5,   5,   0, -10,
+        -5,   0,   5,   5,   5,   5,   0,  -5,
+        -5,   0,   5,   5,   5,   5,   0,  -5,
+       -10,   5,   5,   5,   5,   5,   0, -10,
+       -10,   0,   5,   0,   0,   0,   0, -10,
+       -20, -10, -10,  -5,  -5, -10, -10, -20
+    };
+
+    inline constexpr int eg_queen_scores[PSQT_SQUARES] =
+    {
+       -20, -10, -10, -10, -10, -10, -10, -20,
+       -10,   0,   5,   5,   5,   5,   0, -10,
+       -10,   5,  10,  15,  15,  10,   5, -10,
+       -10,   5,  15,  20,  20,  15,   5, -10,
+       -10,   5,  15,  20,  20,  15,   5, -10,
+       -10,   5,  10,  15,  15,  10,   5, -10,
+       -10,   0,   5,   5,   5,   5,   0, -10,
+       -20, -10, -10, -10, -10, -10, -10, -20
+    };
+
+    //The king hides behind its pawns while the queens and rooks are on
+    inline constexpr int mg_king_scores[PSQT_SQUARES] =
+    {
+       -30, -40, -40, -50, -50, -40, -40, -30,
+       -30, -40, -40, -50, -50, -40, -40, -30,
+       -30, -40, -40, -50, -50, -40, -40, -30,
+       -30, -40, -40, -50, -50, -40, -40, -30,
+       -20, -30, -30, -40, -40, -30, -30, -20,
+       -10, -20, -20, -20, -20, -20, -20, -10,
+        20,  20,   0,   0,   0,   0,  20,  20,
+        20,  30,  10,   0,   0,  10,  30,  20
+    };
+
+    //and walks to the centre in the endgame
+    inline constexpr int eg_king_scores[PSQT_SQUARES] =
+    {
+       -50, -40, -30, -20, -20, -30, -40, -50,
+       -30, -20, -10,   0,   0, -10, -20, -30,
+       -30, -10,  20,  30,  30,  20, -10, -30,
+       -30, -10,  30,  40,  40,  30, -10, -30,
+       -30, -10,  30,  40,  40,  30, -10, -30,
+       -30, -10,  20,  30,  30,  20, -10, -30,
+       -30, -30,   0,   0,   0,   0, -30, -30,
+       -50, -30, -30, -30, -30, -30, -30, -50
+    };
+
+    inline constexpr const int* mg_tables[PSQT_PIECE_TYPES] =
+    {
+        mg_pawn_scores, mg_knight_scores, mg_bishop_scores, mg_rook_scores, mg_queen_scores, mg_king_scores
+    };
+    inline constexpr const int* eg_tables[PSQT_PIECE_TYPES] =
+    {
+        eg_pawn_scores, eg_knight_scores, eg_bishop_scores, eg_rook_scores, eg_queen_scores, eg_king_scores
+    };
+
+    constexpr int MIRROR_RANKS = 56;
+
+    struct PieceSquareTable
+    {
+        Score scores[PSQT_PIECES][PSQT_SQUARES] = {};
+    };
+
+    //Material and position of every piece on every square from white's point of view
+    constexpr PieceSquareTable generate_psqt()
+    {
+        auto table = PieceSquareTable{};
+        for (auto piece = 0; piece < PSQT_PIECE_TYPES; piece++)
+        {
+            for (auto square = 0; square < PSQT_SQUARES; square++)
+            {
+                auto mirrored = square ^ MIRROR_RANKS;
+                table.scores[piece][square] = S(mg_piece_values[piece] + mg_tables[piece][square],
+                                                eg_piece_values[piece] + eg_tables[piece][square]);
+                table.scores[piece + PSQT_PIECE_TYPES][square] =
+                    S(-mg_piece_values[piece] - mg_tables[piece][mirrored],
+                      -eg_piece_values[piece] - eg_tables[piece][mirrored]);
+            }
+        }
+        return table;
+    }
+
+    inline constexpr PieceSquareTable psqt = generate_psqt();
+}
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef PAWNTABLE_H
+#define PAWNTABLE_H
+
+#include "ScoreTable.h"
+
+/** \file PawnTable.h
+    \brief Contains the pawn hash table used by the evaluation
+ */
+
+//Pawn structure changes rarely between nodes, so its evaluation is cached
+//under the pawn only hash key of the board. Scores are from white's point of view.
+class PawnTable : public ScoreTable<PawnTable>
+{
+public:
+    static constexpr int DEFAULT_SIZE_MB = 2;
+};
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef SCORETABLE_H
+#define SCORETABLE_H
+
+#include <vector>
+#include <algorithm>
+
+#include "../BitBoard.h"
+
+/** \file ScoreTable.h
+    \brief Contains the direct mapped score table shared by the evaluation caches
+ */
+
+class ScoreEntry
+{
+public:
+    bitboard key = bitboard{};
+    int score = 0;
+};
+
+//Direct mapped table of scores keyed by a hash key, the newest store always wins.
+//Each cache derives from it with itself as Table, which gives it its own entries and
+//counters and supplies DEFAULT_SIZE_MB. The number of entries is a power of two so
+//the index is the low bits of the key.
+template <typename Table>
+class ScoreTable
+{
+public:
+    static void resize(int megabytes);
+    static void clear();
+    //Returns true and fills in score when the key is in the table
+    static bool probe(bitboard key, int &score);
+    static void store(bitboard key, int score);
+    //Hit counters, reset with reset_counters()
+    static long long get_probes();
+    static long long get_hits();
+    static void reset_counters();
+    static constexpr int MINIMUM_SIZE_MB = 1;
+    static constexpr int MAXIMUM_SIZE_MB = 256;
+private:
+    static constexpr auto BYTES_PER_MEGABYTE = 1024ull * 1024ull;
+    //Largest power of two number of entries that fits in the given size
+    static size_t entries_for(int megabytes);
+    static ScoreEntry& get_entry(bitboard key);
+    static std::vector<ScoreEntry> table_;
+    static bitboard mask_;
+    static long long probes_;
+    static long long hits_;
+};
+
+template <typename Table>
+std::vector<ScoreEntry> ScoreTable<Table>::table_(ScoreTable<Table>::entries_for(Table::DEFAULT_SIZE_MB));
+template <typename Table>
+bitboard ScoreTable<Table>::mask_{ScoreTable<Table>::entries_for(Table::DEFAULT_SIZE_MB) - 1};
+template <typename Table>
+long long ScoreTable<Table>::probes_{0};
+template <typename Table>
+long long ScoreTable<Table>::hits_{0};
+
+template <typename Table>
+size_t ScoreTable<Table>::entries_for(int megabytes)
+{
+    auto entries = size_t{1};
+    while (entries * 2 * sizeof(ScoreEntry) <= megabytes * BYTES_PER_MEGABYTE)
+        entries *= 2;
+    return entries;
+}
+
+template <typename Table>
+void ScoreTable<Table>::resize(int megabytes)
+{
+    if (megabytes < MINIMUM_SIZE_MB)
+        megabytes = MINIMUM_SIZE_MB;
+    if (megabytes > MAXIMUM_SIZE_MB)
+        megabytes = MAXIMUM_SIZE_MB;
+    table_.assign(entries_for(megabytes), ScoreEntry{});
+    mask_ = table_.size() - 1;
+}
+
+template <typename Table>
+void ScoreTable<Table>::clear()
+{
+    std::fill(table_.begin(), table_.end(), ScoreEntry{});
+}
+
+template <typename Table>
+ScoreEntry& ScoreTable<Table>::get_entry(bitboard key)
+{
+    return table_[key & mask_];
+}
+
+template <typename Table>
+bool ScoreTable<Table>::probe(bitboard key, int &score)
+{
+    probes_++;
+    auto &entry = get_entry(key);
+    if (entry.key != key)
+        return false;
+    hits_++;
+    score = entry.score;
+    return true;
+}
+
+template <typename Table>
+void ScoreTable<Table>::store(bitboard key, int score)
+{
+    auto &entry = get_entry(key);
+    entry.key = key;
+    entry.score = score;
+}
+
+template <typename Table>
+long long ScoreTable<Table>::get_probes()
+{
+    return probes_;
+}
+
+template <typename Table>
+long long ScoreTable<Table>::get_hits()
+{
+    return hits_;
+}
+
+template <typename Table>
+void ScoreTable<Table>::reset_counters()
+{
+    probes_ = 0;
+    hits_ = 0;
+}
+
+#endif
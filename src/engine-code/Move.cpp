@@ -1,4 +1,5 @@
 #include "Move.h"
+#include <cctype>
 
 const auto NO_MOVE = 0ul;
 //SHIFTERS
@@ -28,7 +29,7 @@ Move::Move()
     encoded_move = NO_MOVE;
 }
 
-Move::Move(unsigned long move)
+Move::Move(uint32_t move)
 {
     encoded_move = move;
 }
@@ -91,6 +92,46 @@ bool Move::get_move_castling_flag()
     return encoded_move & CASTLING_FLAG;
 }
 
+////////////////////////////////////////////
+//           PACKED MOVE FUNCTIONS        //
+////////////////////////////////////////////
+
+const auto SHIFT_PACKED_PROMOTION = 12u;
+const auto PACKED_SQUARES = 0xFFFu;
+const auto PACKED_PROMOTION_TYPE = 0x7000u;
+//Black promotion pieces are stored as the white piece
+const auto PROMOTION_COLOR_OFFSET = 6;
+
+PackedMove::PackedMove(Move move)
+{
+    auto promotion_type = move.get_move_promotion_type();
+    if (promotion_type > PROMOTION_COLOR_OFFSET)
+        promotion_type -= PROMOTION_COLOR_OFFSET;
+    encoded_move = static_cast<uint16_t>((move.get_move_source_square() |
+                                          (move.get_move_target_square() << SHIFT_TARGET_SQUARE)) |
+                                         (promotion_type << SHIFT_PACKED_PROMOTION));
+}
+
+int PackedMove::get_move_source_square()
+{
+    return encoded_move & SOURCE_SQUARE;
+}
+
+int PackedMove::get_move_target_square()
+{
+    return (encoded_move & TARGET_SQUARE) >> SHIFT_TARGET_SQUARE;
+}
+
+int PackedMove::get_move_promotion_type()
+{
+    return (encoded_move & PACKED_PROMOTION_TYPE) >> SHIFT_PACKED_PROMOTION;
+}
+
+bool PackedMove::is_no_move()
+{
+    return (encoded_move & PACKED_SQUARES) == 0;
+}
+
 #include "BoardState.h"
 
 void Move::print_move()
@@ -118,9 +159,9 @@ std::string Move::get_move_UCI()
     std::string move_string = "";
     move_string = move_string + square_to_coordinate[get_move_source_square()];
     move_string = move_string + square_to_coordinate[get_move_target_square()];
-    std::string promotion_string(1, promotion_pieces[get_move_promotion_type()]);
-    move_string = move_string + promotion_string;
-    move_string = move_string + "\n";
+    //UCI promotions are always lower case, i.e. e7e8q
+    if (get_move_promotion_type())
+        move_string.push_back(tolower(promotion_pieces[get_move_promotion_type()]));
     return move_string;
 }
 
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <string>
+#include <cstdint>
 
 #include "BitBoard.h"
 
@@ -31,7 +32,7 @@ class Move
 public:
     //ENCODERS
     Move();
-    Move(unsigned long move);
+    Move(uint32_t move);
     Move(int source, int target, int piece, int promotion_piece,
          bool capture, bool doublePush, bool en_passant, bool castling);
     void encode_move(int source, int target, int piece, int promotion_piece,
@@ -58,7 +59,29 @@ public:
     bool operator==(Move& rhs);
 
 private:
-    unsigned long encoded_move = 0ul; //This has 32 - bits
+    uint32_t encoded_move = 0u;
+};
+
+/*
+    PackedMove keeps only what the board cannot tell in 16 bits, for tables
+    that store many moves. Boardstate::build_move() turns it back into a Move.
+
+    BINARY VALUE            ENCODED INFO    HEXADECIMAL
+    0000 0000 0011 1111     Source square   0x3F
+    0000 1111 1100 0000     Target square   0xFC0
+    0111 0000 0000 0000     Promotion type  0x7000, white piece or 0 for none
+*/
+class PackedMove
+{
+public:
+    PackedMove() = default;
+    explicit PackedMove(Move move);
+    int get_move_source_square();
+    int get_move_target_square();
+    int get_move_promotion_type();
+    bool is_no_move();
+private:
+    uint16_t encoded_move = 0u;
 };
 
 //Maximum number of moves on 8 x 8 board seems to be 218
@@ -12,6 +12,7 @@
 #include "Pieces/Queen.h"
 #include "Magic.h"
 #include "Timer.h"
+#include "Zobrist.h"
 
 #include "BoardState.h"
 #include "Move.h"
@@ -20,25 +21,16 @@
 #include "../GUI-code/UCI/UCITimer.h"
 
 #include "Evaluation/BasicEval.h"
+#include "Search/Search.h"
 
 using namespace std;
 
 int main ()
 {
-    //ALL INITS to be moved to single function later
-    //Initialize pawn attack tables
-    PawnAttacks::init();
-    //Initialize knight attack tables
-    KnightAttacks::init();
-    //Initialize king attack tables
-    KingAttacks::init();
-    //Init magic numbers
-    //Magic::init_magic_numbers();
-    //KEEP MAGIC INITS
-    //Initialize Bishop attack tables
-    BishopAttacks::init();
-    //Initialize Rook attack tables
-    RookAttacks::init();
+    auto startup_time = UCITimer::get_time_ns();
+    //Attack tables and Zobrist keys are generated at compile time, only this is left to runtime
+    //Initialize late move reduction table
+    NegaMax::init_reductions();
 
     // FEN dedug positions
     //char* empty_board = "8/8/8/8/8/8/8/8 w - - 0 0";
@@ -78,6 +70,7 @@ int main ()
     else
     {
         auto UCI = UCI_Link{};
+        UCI.set_startup_time(UCITimer::get_time_ns() - startup_time);
         UCI.UCI_loop();
     }
 
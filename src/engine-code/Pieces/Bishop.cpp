@@ -5,67 +5,28 @@ bitboard BishopAttacks::get_bishop_occupancy_bits(int square)
     return mask_bishop_occupancies(square);
 }
 
-bitboard BishopAttacks::gen_bishop_attacks_on_the_fly(int square, bitboard blocker)
+//Every subset of a square's blocker mask is visited with the carry rippler
+//(subset - mask) & mask and its attacks stored at the subset's magic index
+static constexpr BishopAttacks::AttackTable generate_bishop_attacks()
 {
-    //Initialize attack bitmap output variable
-    auto attacks = EMPTY_BITMAP;
-    //Initialize rank and file variables
-    auto rank = 0;
-    auto file = 0;
-    auto targRank = square / SQUARES_IN_ROW;
-    auto targFile = square % SQUARES_IN_ROW;
-    //Mask attack bits for each direction with blockers accounted for
-    //Down and right
-    for (rank = targRank + 1, file = targFile + 1; rank <= IN_LAST_R_F && file <= IN_LAST_R_F; rank++, file++)
+    auto table = BishopAttacks::AttackTable{};
+    for (auto square = 0; square < BishopAttacks::NUM_SQUARES; square++)
     {
-        attacks |= (ONE_SHIFT << (rank * SQUARES_IN_ROW + file));
-        if (ONE_SHIFT << (rank * SQUARES_IN_ROW + file) & blocker) break;
-    }
-    //Up and right
-    for (rank = targRank - 1, file = targFile + 1; rank >= IN_FIRST_R_F && file <= IN_LAST_R_F; rank--, file++)
-    {
-        attacks |= (ONE_SHIFT << (rank * SQUARES_IN_ROW + file));
-        if (ONE_SHIFT << (rank * SQUARES_IN_ROW + file) & blocker) break;
-    }
-    //Down and left
-    for (rank = targRank + 1, file = targFile - 1; rank <= IN_LAST_R_F && file >= IN_FIRST_R_F; rank++, file--)
-    {
-        attacks |= (ONE_SHIFT << (rank * SQUARES_IN_ROW + file));
-        if (ONE_SHIFT << (rank * SQUARES_IN_ROW + file) & blocker) break;
-    }
-    //Up and left
-    for (rank = targRank - 1, file = targFile - 1; rank >= IN_FIRST_R_F && file >= IN_FIRST_R_F; rank--, file--)
-    {
-        attacks |= (ONE_SHIFT << (rank * SQUARES_IN_ROW + file));
-        if (ONE_SHIFT << (rank * SQUARES_IN_ROW + file) & blocker) break;
-    }
-    return attacks;
-}
-
-//Necessary or the Magic:: functions are not available
-#include "../Magic.h"
-
-void BishopAttacks::init()
-{
-    for (auto square = 0; square < NUM_SQUARES; square++)
-    {
-        bishop_masks[square] = mask_bishop_occupancies(square);
-        auto attack_mask = bishop_masks[square];
-        auto occupancy_bit_count = Bitboard::count_bits(attack_mask);
-        auto occupancy_indices = (ONE_SHIFT << occupancy_bit_count);
-        for (auto index = 0; index < occupancy_indices; index++)
+        auto attack_mask = BishopAttacks::bishop_masks[square];
+        auto occupancy = BishopAttacks::EMPTY_BITMAP;
+        do
         {
-            auto occ = Magic::set_occupancy(index, occupancy_bit_count, attack_mask);
-            auto magic_index = (occ * Magic::bishop_magic_numbers[square]) >> (NUM_SQUARES - bishop_occupancy_bit_count[square]);
-            bishop_attacks[square][magic_index] = gen_bishop_attacks_on_the_fly(square, occ);
-        }
+            table[BishopAttacks::get_bishop_index(square, occupancy)] =
+                BishopAttacks::gen_bishop_attacks_on_the_fly(square, occupancy);
+            occupancy = (occupancy - attack_mask) & attack_mask;
+        } while (occupancy);
     }
+    return table;
 }
 
+constexpr BishopAttacks::AttackTable BishopAttacks::bishop_attacks = generate_bishop_attacks();
+
 bitboard BishopAttacks::get_bishop_attacks(int square, bitboard occupancy)
 {
-    occupancy &= bishop_masks[square];
-    occupancy *= Magic::bishop_magic_numbers[square];
-    occupancy >>= NUM_SQUARES - bishop_occupancy_bit_count[square];
-    return bishop_attacks[square][occupancy];
+    return bishop_attacks[get_bishop_index(square, occupancy)];
 }
@@ -1,7 +1,10 @@
 #ifndef BISHOP_H
 #define BISHOP_H
 
+#include <array>
+
 #include "../BitBoard.h"
+#include "../MagicNumbers.h"
 
 /** \file Bishop.h
     \brief Contains Bishop class
@@ -60,29 +63,76 @@ namespace BishopAttacks
     }
 
     //Used to generate the bishop attacks accounting for blocking pieces
-    //Used in precalc but not constexpr for table creation
-    bitboard gen_bishop_attacks_on_the_fly(int square, bitboard blocker);
-
-    //Bishop occupancy bit count for every square on the board
-    constexpr int bishop_occupancy_bit_count[NUM_SQUARES] = {
-        6, 5, 5, 5, 5, 5, 5, 6,
-        5, 5, 5, 5, 5, 5, 5, 5,
-        5, 5, 7, 7, 7, 7, 5, 5,
-        5, 5, 7, 9, 9, 7, 5, 5,
-        5, 5, 7, 9, 9, 7, 5, 5,
-        5, 5, 7, 7, 7, 7, 5, 5,
-        5, 5, 5, 5, 5, 5, 5, 5,
-        6, 5, 5, 5, 5, 5, 5, 6
-    };
+    constexpr bitboard gen_bishop_attacks_on_the_fly(int square, bitboard blocker)
+    {
+        //Initialize attack bitmap output variable
+        auto attacks = EMPTY_BITMAP;
+        //Initialize rank and file variables
+        auto rank = 0;
+        auto file = 0;
+        auto targRank = square / SQUARES_IN_ROW;
+        auto targFile = square % SQUARES_IN_ROW;
+        //Mask attack bits for each direction with blockers accounted for
+        //Down and right
+        for (rank = targRank + 1, file = targFile + 1; rank <= IN_LAST_R_F && file <= IN_LAST_R_F; rank++, file++)
+        {
+            attacks |= (ONE_SHIFT << (rank * SQUARES_IN_ROW + file));
+            if (ONE_SHIFT << (rank * SQUARES_IN_ROW + file) & blocker) break;
+        }
+        //Up and right
+        for (rank = targRank - 1, file = targFile + 1; rank >= IN_FIRST_R_F && file <= IN_LAST_R_F; rank--, file++)
+        {
+            attacks |= (ONE_SHIFT << (rank * SQUARES_IN_ROW + file));
+            if (ONE_SHIFT << (rank * SQUARES_IN_ROW + file) & blocker) break;
+        }
+        //Down and left
+        for (rank = targRank + 1, file = targFile - 1; rank <= IN_LAST_R_F && file >= IN_FIRST_R_F; rank++, file--)
+        {
+            attacks |= (ONE_SHIFT << (rank * SQUARES_IN_ROW + file));
+            if (ONE_SHIFT << (rank * SQUARES_IN_ROW + file) & blocker) break;
+        }
+        //Up and left
+        for (rank = targRank - 1, file = targFile - 1; rank >= IN_FIRST_R_F && file >= IN_FIRST_R_F; rank--, file--)
+        {
+            attacks |= (ONE_SHIFT << (rank * SQUARES_IN_ROW + file));
+            if (ONE_SHIFT << (rank * SQUARES_IN_ROW + file) & blocker) break;
+        }
+        return attacks;
+    }
+
+    constexpr std::array<bitboard, NUM_SQUARES> generate_bishop_masks()
+    {
+        auto masks = std::array<bitboard, NUM_SQUARES>{};
+        for (auto square = 0; square < NUM_SQUARES; square++)
+            masks[square] = mask_bishop_occupancies(square);
+        return masks;
+    }
 
     //Defines bishop attack masks
-    inline bitboard bishop_masks[NUM_SQUARES] = {};
-    //Total number of occupancy bytes
-    const auto BYTES_FOR_OCCUPANCIES = 512;
-    //Defines bishop attack table
-    inline bitboard bishop_attacks[NUM_SQUARES][BYTES_FOR_OCCUPANCIES] = {};
-    //Init Bishop attacks
-    void init();
+    inline constexpr std::array<bitboard, NUM_SQUARES> bishop_masks = generate_bishop_masks();
+    //Start of every square's attacks in the table, a square takes 2^index bits entries
+    constexpr std::array<int, NUM_SQUARES + 1> generate_bishop_offsets()
+    {
+        auto offsets = std::array<int, NUM_SQUARES + 1>{};
+        for (auto square = 0; square < NUM_SQUARES; square++)
+            offsets[square + 1] = offsets[square] + (1 << Magic::bishop_index_bits[square]);
+        return offsets;
+    }
+
+    inline constexpr std::array<int, NUM_SQUARES + 1> bishop_offsets = generate_bishop_offsets();
+    //One flat table sized by the magics' index bits
+    using AttackTable = std::array<bitboard, bishop_offsets[NUM_SQUARES]>;
+    //Defines bishop attack table, generated at compile time in Bishop.cpp so it
+    //is read only data shared by every engine process through the page cache
+    extern const AttackTable bishop_attacks;
+
+    //Position of an occupancy's attacks in bishop_attacks
+    constexpr int get_bishop_index(int square, bitboard occupancy)
+    {
+        return bishop_offsets[square] +
+               static_cast<int>(((occupancy & bishop_masks[square]) * Magic::bishop_magic_numbers[square]) >>
+                                (NUM_SQUARES - Magic::bishop_index_bits[square]));
+    }
 
     //FIND A WAY TO MAKE THIS STATIC INLINE TO IMPROVE MOVE GEN SPEED
     bitboard get_bishop_attacks(int square, bitboard occupancy);
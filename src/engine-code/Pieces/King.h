@@ -1,6 +1,8 @@
 #ifndef KING_H
 #define KING_H
 
+#include <array>
+
 #include "../BitBoard.h"
 #include "Pawn.h"
 
@@ -23,9 +25,6 @@ namespace KingAttacks
     constexpr auto MOVE_UP_LEFT = 9ull;
     constexpr auto MOVE_LEFT = 1ull;
 
-    //Array of precomputed king attack masks
-    inline bitboard king_attacks[NUM_SQUARES];
-
     //Mask king attacks for specific piece
     constexpr bitboard mask_king_attacks(int square)
     {
@@ -54,14 +53,19 @@ namespace KingAttacks
         return attacks;
     }
 
-    //Initialize king attacks
-    constexpr void init()
+    //Generate king attacks
+    constexpr std::array<bitboard, NUM_SQUARES> generate_king_attacks()
     {
+        auto attacks = std::array<bitboard, NUM_SQUARES>{};
         for (auto square = 0; square < NUM_SQUARES; square++)
         {
-            king_attacks[square] = mask_king_attacks(square);
+            attacks[square] = mask_king_attacks(square);
         }
+        return attacks;
     }
+
+    //Array of precomputed king attack masks
+    inline constexpr std::array<bitboard, NUM_SQUARES> king_attacks = generate_king_attacks();
 }
 
 
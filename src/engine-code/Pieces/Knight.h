@@ -1,6 +1,8 @@
 #ifndef KNIGHT_H
 #define KNIGHT_H
 
+#include <array>
+
 #include "../BitBoard.h"
 #include "Pawn.h"
 
@@ -52,9 +54,6 @@ namespace KnightAttacks
     constexpr auto LEAP_MID_RIGHT = 6ull;
     constexpr auto LEAP_MID_LEFT = 10ull;
 
-    //Array of precomputed knight attack masks
-    inline bitboard knight_attacks[NUM_SQUARES];
-
     //Mask knight attacks for specific piece
     constexpr bitboard mask_knight_attacks(int square)
     {
@@ -83,14 +82,19 @@ namespace KnightAttacks
         return attacks;
     }
 
-    //Initialize knight attacks
-    constexpr void init()
+    //Generate knight attacks
+    constexpr std::array<bitboard, NUM_SQUARES> generate_knight_attacks()
     {
+        auto attacks = std::array<bitboard, NUM_SQUARES>{};
         for (auto square = 0; square < NUM_SQUARES; square++)
         {
-            knight_attacks[square] = mask_knight_attacks(square);
+            attacks[square] = mask_knight_attacks(square);
         }
+        return attacks;
     }
+
+    //Array of precomputed knight attack masks
+    inline constexpr std::array<bitboard, NUM_SQUARES> knight_attacks = generate_knight_attacks();
 }
 
 
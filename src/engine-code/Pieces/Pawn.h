@@ -1,6 +1,8 @@
 #ifndef PAWN_H
 #define PAWN_H
 
+#include <array>
+
 #include "../BitBoard.h"
 
 /** \file Pawn.h
@@ -8,9 +10,8 @@
  */
 
 
-//Used to define precalculated pawn attacks in an array for later lookups
-//Before this can be used the PawnAttacks::init() function must be called
-//in main to ensure the array is populated.
+//Used to define precalculated pawn attacks in an array for later lookups,
+//the array is generated at compile time
 namespace PawnAttacks
 {
     //Define constants for array definition
@@ -55,9 +56,6 @@ namespace PawnAttacks
     constexpr auto BOTTOM_LEFT_AND_TOP_RIGHT_DIAG_SHIFT = 7ull;
     constexpr auto TOP_LEFT_AND_BOTTOM_RIGHT_DIAG_SHIFT = 9ull;
 
-    //Array of precomputed pawn attack masks
-    inline bitboard pawn_attacks[NUM_COLORS][NUM_SQUARES];
-
     //Mask pawn attacks for specific piece
     constexpr bitboard mask_pawn_attacks(int color, int square)
     {
@@ -82,16 +80,21 @@ namespace PawnAttacks
         return attacks;
     }
 
-    //Initialize Pawn attacks
-    constexpr void init()
+    //Generate Pawn attacks
+    constexpr std::array<std::array<bitboard, NUM_SQUARES>, NUM_COLORS> generate_pawn_attacks()
     {
+        auto attacks = std::array<std::array<bitboard, NUM_SQUARES>, NUM_COLORS>{};
         for (auto square = 0; square < NUM_SQUARES; square++)
         {
-            pawn_attacks[white][square] = mask_pawn_attacks(white,square);
-            pawn_attacks[black][square] = mask_pawn_attacks(black,square);
+            attacks[white][square] = mask_pawn_attacks(white,square);
+            attacks[black][square] = mask_pawn_attacks(black,square);
         }
+        return attacks;
     }
 
+    //Array of precomputed pawn attack masks
+    inline constexpr std::array<std::array<bitboard, NUM_SQUARES>, NUM_COLORS> pawn_attacks = generate_pawn_attacks();
+
 };
 
 
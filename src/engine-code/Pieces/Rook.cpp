@@ -1,74 +1,58 @@
 #include "Rook.h"
 
+#include <utility>
+
 bitboard RookAttacks::get_rook_occupancy_bits(int square)
 {
     return mask_rook_occupancies(square);
 }
 
-bitboard RookAttacks::gen_rook_attacks_on_the_fly(int square, bitboard blocker)
+template <int square>
+using SquareAttacks = std::array<bitboard, 1 << Magic::rook_index_bits[square]>;
+
+//Every subset of a square's blocker mask is visited with the carry rippler
+//(subset - mask) & mask and its attacks stored at the subset's magic index
+template <int square>
+static constexpr SquareAttacks<square> generate_rook_square_attacks()
 {
-    //Initialize attack bitmap output variable
-    auto attacks = EMPTY_BITMAP;
-    //Initialize rank and file variables
-    auto rank = 0;
-    auto file = 0;
-    auto targRank = square / SQUARES_IN_ROW;
-    auto targFile = square % SQUARES_IN_ROW;
-    //Mask attack bits for each direction:
-    //Down
-    for (rank = targRank + 1; rank <= IN_LAST_R_F; rank++)
-    {
-        attacks |= (ONE_SHIFT << (rank * SQUARES_IN_ROW + targFile));
-        if (ONE_SHIFT << (rank * SQUARES_IN_ROW + targFile) & blocker) break;
-    }
-    //Up
-    for (rank = targRank - 1; rank >= IN_FIRST_R_F; rank--)
-    {
-        attacks |= (ONE_SHIFT << (rank * SQUARES_IN_ROW + targFile));
-        if (ONE_SHIFT << (rank * SQUARES_IN_ROW + targFile) & blocker) break;
-    }
-    //Right
-    for (file = targFile + 1; file <= IN_LAST_R_F; file++)
-    {
-        attacks |= (ONE_SHIFT << (targRank * SQUARES_IN_ROW + file));
-        if (ONE_SHIFT << (targRank * SQUARES_IN_ROW + file) & blocker) break;
-    }
-    //Left
-    for (file = targFile - 1; file >= IN_FIRST_R_F; file--)
+    auto attacks = SquareAttacks<square>{};
+    auto attack_mask = RookAttacks::rook_masks[square];
+    auto occupancy = RookAttacks::EMPTY_BITMAP;
+    do
     {
-        attacks |= (ONE_SHIFT << (targRank * SQUARES_IN_ROW + file));
-        if (ONE_SHIFT << (targRank * SQUARES_IN_ROW + file) & blocker) break;
-    }
+        attacks[RookAttacks::get_rook_index(square, occupancy) - RookAttacks::rook_offsets[square]] =
+            RookAttacks::gen_rook_attacks_on_the_fly(square, occupancy);
+        occupancy = (occupancy - attack_mask) & attack_mask;
+    } while (occupancy);
     return attacks;
 }
 
-//Necessary or the Magic:: functions are not available
-#include "../Magic.h"
+//Every square is its own constant evaluation, the whole table in one goes past the
+//compiler's default constexpr operation limit
+template <int square>
+constexpr SquareAttacks<square> rook_square_attacks = generate_rook_square_attacks<square>();
 
-void RookAttacks::init()
+template <int square>
+static constexpr void copy_rook_square_attacks(RookAttacks::AttackTable &table)
 {
-    for (auto square = 0; square < NUM_SQUARES; square++)
-    {
-        rook_masks[square] = mask_rook_occupancies(square);
-        auto attack_mask = rook_masks[square];
-        auto occupancy_bit_count = Bitboard::count_bits(attack_mask);
-        auto occupancy_indices = (ONE_SHIFT << occupancy_bit_count);
-        for (auto index = 0; index < occupancy_indices; index++)
-        {
-            auto occ = Magic::set_occupancy(index, occupancy_bit_count, attack_mask);
-            auto magic_index = (occ * Magic::rook_magic_numbers[square]) >> (NUM_SQUARES - rook_occupancy_bit_count[square]);
-            rook_attacks[square][magic_index] = gen_rook_attacks_on_the_fly(square, occ);
-        }
+    for (auto index = 0; index < static_cast<int>(rook_square_attacks<square>.size()); index++)
+        table[RookAttacks::rook_offsets[square] + index] = rook_square_attacks<square>[index];
+}
 
-    }
+template <int... squares>
+static constexpr RookAttacks::AttackTable generate_rook_attacks(std::integer_sequence<int, squares...>)
+{
+    auto table = RookAttacks::AttackTable{};
+    (copy_rook_square_attacks<squares>(table), ...);
+    return table;
 }
 
+constexpr RookAttacks::AttackTable RookAttacks::rook_attacks =
+    generate_rook_attacks(std::make_integer_sequence<int, RookAttacks::NUM_SQUARES>{});
+
 bitboard RookAttacks::get_rook_attacks(int square, bitboard occupancy)
 {
-    occupancy &= rook_masks[square];
-    occupancy *= Magic::rook_magic_numbers[square];
-    occupancy >>= NUM_SQUARES - rook_occupancy_bit_count[square];
-    return rook_attacks[square][occupancy];
+    return rook_attacks[get_rook_index(square, occupancy)];
 }
 
 
@@ -1,7 +1,10 @@
 #ifndef ROOK_H
 #define ROOK_H
 
+#include <array>
+
 #include "../BitBoard.h"
+#include "../MagicNumbers.h"
 
 /** \file Rook.h
     \brief Contains Rook class
@@ -52,29 +55,76 @@ namespace RookAttacks
     }
 
     //Used to generate the rook attacks accounting for blocking pieces
-    //Used in precalc but not constexpr for table creation
-    bitboard gen_rook_attacks_on_the_fly(int square, bitboard blocker);
-
-    //Rook occupancy bit count for every square on the board
-    constexpr int rook_occupancy_bit_count[NUM_SQUARES] = {
-        12, 11, 11, 11, 11, 11, 11, 12,
-        11, 10, 10, 10, 10, 10, 10, 11,
-        11, 10, 10, 10, 10, 10, 10, 11,
-        11, 10, 10, 10, 10, 10, 10, 11,
-        11, 10, 10, 10, 10, 10, 10, 11,
-        11, 10, 10, 10, 10, 10, 10, 11,
-        11, 10, 10, 10, 10, 10, 10, 11,
-        12, 11, 11, 11, 11, 11, 11, 12
-    };
+    constexpr bitboard gen_rook_attacks_on_the_fly(int square, bitboard blocker)
+    {
+        //Initialize attack bitmap output variable
+        auto attacks = EMPTY_BITMAP;
+        //Initialize rank and file variables
+        auto rank = 0;
+        auto file = 0;
+        auto targRank = square / SQUARES_IN_ROW;
+        auto targFile = square % SQUARES_IN_ROW;
+        //Mask attack bits for each direction:
+        //Down
+        for (rank = targRank + 1; rank <= IN_LAST_R_F; rank++)
+        {
+            attacks |= (ONE_SHIFT << (rank * SQUARES_IN_ROW + targFile));
+            if (ONE_SHIFT << (rank * SQUARES_IN_ROW + targFile) & blocker) break;
+        }
+        //Up
+        for (rank = targRank - 1; rank >= IN_FIRST_R_F; rank--)
+        {
+            attacks |= (ONE_SHIFT << (rank * SQUARES_IN_ROW + targFile));
+            if (ONE_SHIFT << (rank * SQUARES_IN_ROW + targFile) & blocker) break;
+        }
+        //Right
+        for (file = targFile + 1; file <= IN_LAST_R_F; file++)
+        {
+            attacks |= (ONE_SHIFT << (targRank * SQUARES_IN_ROW + file));
+            if (ONE_SHIFT << (targRank * SQUARES_IN_ROW + file) & blocker) break;
+        }
+        //Left
+        for (file = targFile - 1; file >= IN_FIRST_R_F; file--)
+        {
+            attacks |= (ONE_SHIFT << (targRank * SQUARES_IN_ROW + file));
+            if (ONE_SHIFT << (targRank * SQUARES_IN_ROW + file) & blocker) break;
+        }
+        return attacks;
+    }
+
+    constexpr std::array<bitboard, NUM_SQUARES> generate_rook_masks()
+    {
+        auto masks = std::array<bitboard, NUM_SQUARES>{};
+        for (auto square = 0; square < NUM_SQUARES; square++)
+            masks[square] = mask_rook_occupancies(square);
+        return masks;
+    }
 
     //Defines Rook attack masks
-    inline bitboard rook_masks[NUM_SQUARES] = {};
-    //Total number of occupancy bytes
-    const auto BYTES_FOR_OCCUPANCIES = 4096;
-    //Defines Rook attack table
-    inline bitboard rook_attacks[NUM_SQUARES][BYTES_FOR_OCCUPANCIES] = {};
-    //Init Rook attacks
-    void init();
+    inline constexpr std::array<bitboard, NUM_SQUARES> rook_masks = generate_rook_masks();
+    //Start of every square's attacks in the table, a square takes 2^index bits entries
+    constexpr std::array<int, NUM_SQUARES + 1> generate_rook_offsets()
+    {
+        auto offsets = std::array<int, NUM_SQUARES + 1>{};
+        for (auto square = 0; square < NUM_SQUARES; square++)
+            offsets[square + 1] = offsets[square] + (1 << Magic::rook_index_bits[square]);
+        return offsets;
+    }
+
+    inline constexpr std::array<int, NUM_SQUARES + 1> rook_offsets = generate_rook_offsets();
+    //One flat table sized by the magics' index bits
+    using AttackTable = std::array<bitboard, rook_offsets[NUM_SQUARES]>;
+    //Defines Rook attack table, generated at compile time in Rook.cpp so it
+    //is read only data shared by every engine process through the page cache
+    extern const AttackTable rook_attacks;
+
+    //Position of an occupancy's attacks in rook_attacks
+    constexpr int get_rook_index(int square, bitboard occupancy)
+    {
+        return rook_offsets[square] +
+               static_cast<int>(((occupancy & rook_masks[square]) * Magic::rook_magic_numbers[square]) >>
+                                (NUM_SQUARES - Magic::rook_index_bits[square]));
+    }
 
     //FIND A WAY TO MAKE THIS STATIC INLINE TO IMPROVE MOVE GEN SPEED
     bitboard get_rook_attacks(int square, bitboard occupancy);
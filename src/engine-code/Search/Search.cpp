@@ -1,6 +1,10 @@
 #include "Search.h"
 
+#include <cmath>
 #include <iostream>
+#include <algorithm>
+
+static_assert(ACCUMULATOR_STACK_SIZE > MAX_PLY, "the accumulator stack must hold a whole search line");
 
 using namespace std;
 
@@ -44,93 +48,215 @@ Move RandomEngine::get_best_move()
 //                       NegaMax                         //
 ///////////////////////////////////////////////////////////
 
-constexpr auto SIDE_TO_MOVE_SHIFT = 1;
 
 constexpr auto MAXIMIM_SCORE = 50000;
 constexpr auto MINIMUM_SCORE = -50000;
 constexpr auto ASPIRATION_WINDOW_SCORE = 50;
 constexpr auto CHECK_MATE_SCORE = 49000;
 constexpr auto DRAW_SCORE = 0;
+constexpr unsigned int FIFTY_MOVE_RULE_PLIES = 100u;
 constexpr int FIRST_KILLER_MOVE_INDEX = 0;
 constexpr int SECOND_KILLER_MOVE_INDEX = 1;
 constexpr int NULL_MOVE_PRUNING_DEPTH = 3;
 constexpr int REDUCTION_LIMIT = 2;
-constexpr int NODE_POLL_FREQ = 2047;
+constexpr long long NO_NODE_LIMIT = 0;
+//Each history table is kept within plus or minus this bound by the gravity update
+constexpr int HISTORY_MAXIMUM = 2000;
+constexpr int HISTORY_BONUS_SCALE = 32;
+constexpr int HISTORY_BONUS_MAXIMUM = 1200;
+constexpr int ONE_PLY_BACK = 1;
+constexpr int TWO_PLIES_BACK = 2;
+constexpr int SEE_QUIESCENCE_THRESHOLD = 0;
+//Scores closer to mate than this are never pruned on static evaluation
+constexpr int MATE_BOUND = CHECK_MATE_SCORE - MAX_PLY;
+constexpr int REVERSE_FUTILITY_DEPTH = 3;
+constexpr int REVERSE_FUTILITY_MARGIN = 120;
+constexpr int RAZORING_DEPTH = 2;
+constexpr int RAZORING_MARGIN = 300;
+constexpr int FUTILITY_DEPTH = 3;
+constexpr int FUTILITY_MARGIN = 150;
+constexpr int DELTA_MARGIN = 200;
+constexpr double REDUCTION_BASE = 0.75;
+constexpr double REDUCTION_DIVISOR = 2.25;
+constexpr int HISTORY_REDUCTION_DIVISOR = 2000;
+constexpr int LATE_MOVE_PRUNING_DEPTH = 3;
+constexpr int LATE_MOVE_PRUNING_BASE = 3;
+constexpr int HISTORY_DECAY = 2;
+constexpr int KILLER_SHIFT = 2;
+constexpr long long PROGRESS_REPORT_INTERVAL = 1000;
 
 long long NegaMax::nodes_{0};
+long long NegaMax::node_limit_{NO_NODE_LIMIT};
+MoveList NegaMax::search_moves_{};
+bool NegaMax::pruning_enabled_[NUM_PRUNING_TYPES]{true, true, true, true};
 int NegaMax::ply_{0};
+int NegaMax::seldepth_{0};
+int NegaMax::root_depth_{0};
+Move NegaMax::root_move_{};
+int NegaMax::root_move_number_{0};
+long long NegaMax::search_start_time_{0};
+long long NegaMax::last_report_time_{0};
 //Move NegaMax::best_move{};
-Move NegaMax::killer_moves[][MAX_PLY];
+SearchStack NegaMax::search_stack[MAX_PLY];
 int NegaMax::history_moves[][MAX_PLY];
+ContinuationHistory NegaMax::continuation_history[NUM_PIECE_TYPES][NUM_SQUARES];
+Move NegaMax::counter_moves[NUM_PIECE_TYPES][NUM_SQUARES];
 int NegaMax::PV_length[];
 Move NegaMax::PV_table[][MAX_PLY];
+Move NegaMax::hash_moves[];
 bool NegaMax::following_PV_{false};
 bool NegaMax::evaluate_PV_{false};
 int NegaMax::reduction_limit{3};
 int NegaMax::full_depth_moves{4};
+int NegaMax::reductions[][MAX_MOVES_PER_POS];
+
+void NegaMax::init_reductions()
+{
+    for (auto depth = 0; depth < MAX_PLY; depth++)
+    {
+        for (auto move_number = 0; move_number < MAX_MOVES_PER_POS; move_number++)
+        {
+            reductions[depth][move_number] = ((depth == 0) || (move_number == 0)) ? 0 :
+                static_cast<int>(REDUCTION_BASE + std::log(depth) * std::log(move_number) / REDUCTION_DIVISOR);
+        }
+    }
+}
 UCITimer NegaMax::gameTimer{};
 
 int NegaMax::find_best_move(std::shared_ptr<Boardstate> board_state, int alpha, int beta, int depth)
 {
-    //Quick stop as needed
-    if((nodes_ & NODE_POLL_FREQ ) == 0) {
+    //Quick stop as needed, the clock is only read once the node budget is used up
+    if(gameTimer.poll_due(nodes_)) {
         // "listen" to the GUI/user input
-		gameTimer.communicate();
+		gameTimer.communicate(nodes_);
+        report_progress();
     }
-    //Init the principle value length
+    //Unwind without searching once stopped
+    if (gameTimer.get_stopped())
+        return 0;
+    //Init the principle value length, before the ply limit so the parent sees an empty line
     PV_length[ply_] = ply_;
-    //Exit recursive loop with evaluation of position
-    if (depth == 0)
-        return NegaMax::quiescence_search(board_state,alpha,beta);
     //Ensure that engine does not crash by searching at a depth that is too large
     if (ply_ >= MAX_PLY)
         return BasicEval::evaluate(board_state);
+    //Track the selective depth
+    if (ply_ > seldepth_)
+        seldepth_ = ply_;
+    //Repeated positions and the fifty move rule are draws below the root
+    if ((ply_ > 0) && (board_state->is_repetition() ||
+                       board_state->get_halfmove_count() >= FIFTY_MOVE_RULE_PLIES))
+        return DRAW_SCORE;
+    //Only nodes with an open window can be on the principle variation
+    bool pv_node = (beta - alpha) > 1;
+    auto &stack = search_stack[ply_];
+    //Probe the transposition table, the hash move is kept for ordering even without a cut off
+    auto hash_move = PackedMove{};
+    auto hash_score = TranspositionTable::probe(board_state->get_hash_key(), depth, alpha, beta, ply_, hash_move);
+    hash_moves[ply_] = board_state->build_move(hash_move);
+    if ((ply_ > 0) && (hash_score != NO_HASH_ENTRY) && !pv_node)
+        return hash_score;
+    //Exit recursive loop with evaluation of position
+    if (depth == 0)
+        return NegaMax::quiescence_search(board_state, alpha, beta, NO_STATIC_EVAL);
     //Increment the number of nodes traversed
     nodes_++;
-    //Init king is in check or not or given boardstate
-    bool is_king_in_check = board_state->is_square_attacked(
-                            (board_state->get_side_to_move() == white) ?
-                            Bitboard::get_lsb_index(board_state->get_piece_bitboards()[K]) :
-                            Bitboard::get_lsb_index(board_state->get_piece_bitboards()[k]),
-                            board_state->get_side_to_move() ^ SIDE_TO_MOVE_SHIFT);
+    //Hard node limit for reproducible searches
+    if ((node_limit_ != NO_NODE_LIMIT) && (nodes_ >= node_limit_))
+        gameTimer.set_stopped(true);
+    //The parent already found out whether its move gave check
+    bool is_king_in_check = (ply_ > 0) ? search_stack[ply_ - ONE_PLY_BACK].gives_check : is_in_check(board_state);
     //If king in check then increase search depth to ensure no unforeseen mates
     if (is_king_in_check) depth++;
+    //The static evaluation only guides pruning away from the principle variation and out of check
+    bool can_prune = !pv_node && !is_king_in_check && (ply_ > 0);
+    stack.in_check = is_king_in_check;
+    stack.static_eval = is_king_in_check ? NO_STATIC_EVAL : BasicEval::evaluate(board_state);
+    int static_eval = stack.static_eval;
+    //Improving when the static evaluation is better than on our previous move
+    bool improving = !is_king_in_check && ((ply_ < 2) || (search_stack[ply_ - 2].static_eval == NO_STATIC_EVAL) ||
+                                           (static_eval > search_stack[ply_ - 2].static_eval));
+    //Reverse futility pruning, so far above beta that no quiet reply brings the score back
+    if (can_prune && pruning_enabled_[reverse_futility_pruning] && (depth <= REVERSE_FUTILITY_DEPTH) &&
+        (std::abs(beta) < MATE_BOUND) && (static_eval - REVERSE_FUTILITY_MARGIN * depth >= beta))
+        return beta;
+    //Razoring, far below alpha so only captures are worth verifying
+    if (can_prune && pruning_enabled_[razoring] && (depth <= RAZORING_DEPTH) &&
+        (static_eval + RAZORING_MARGIN * depth < alpha))
+    {
+        auto score = NegaMax::quiescence_search(board_state, alpha, alpha + 1, static_eval);
+        if (score <= alpha)
+            return alpha;
+    }
+    //Futility pruning, quiet moves are skipped when even a margin cannot lift them to alpha
+    bool futile = can_prune && pruning_enabled_[futility_pruning] && (depth <= FUTILITY_DEPTH) &&
+                  (std::abs(alpha) < MATE_BOUND) && (static_eval + FUTILITY_MARGIN * depth <= alpha);
     //Init legal move counter
     auto legal_moves = 0;
-    //Null move pruning
-    if ((depth >= NULL_MOVE_PRUNING_DEPTH) && (is_king_in_check == false) && (ply_ >= 1)) {
+    //Null move pruning, only worth trying when already at or above beta
+    if ((depth >= NULL_MOVE_PRUNING_DEPTH) && (is_king_in_check == false) && (ply_ >= 1) && (static_eval >= beta)) {
         //Make copy of state
         auto copy_of_null_state = BoardstateCopy{};
         board_state->make_copy(copy_of_null_state);
-        board_state->set_side_to_move(!board_state->get_side_to_move());
-        board_state->set_en_passant_square(no_sq);
+        board_state->make_null_move();
+        stack.current_move = Move{};
+        stack.gives_check = false;
+        stack.continuation_history = nullptr;
+        ply_++;
         auto score = -NegaMax::find_best_move(board_state, -beta, -beta + 1, depth - 1 - REDUCTION_LIMIT);
+        ply_--;
         board_state->restore_copy(copy_of_null_state);
         if (score >= beta) {
             return beta;
         }
     }
-    //Generate empty movelist and populate for current boardstate
+    //The hash move is searched before generating moves, a cut off skips generation entirely.
+    //While following the principle variation the PV move has to come first instead.
     auto move_list = MoveList{};
-    board_state->generate_moves(move_list);
-    //Find principle variation
-    if (following_PV_) {
-        enable_PV_scoring(move_list);
-    }
-    //Order moves to increase alpha beta pruning speed
-    Search::sort_moves(board_state, move_list);
+    auto moves_generated = false;
+    if (!following_PV_ && board_state->is_pseudo_legal(hash_moves[ply_]))
+        move_list.add_move(hash_moves[ply_]);
     //Number of moves searched
     auto moves_searched = 0;
+    //Quiet moves that did not cause a cut off, their histories are lowered if another move does
+    auto quiets_searched = MoveList{};
+    //Type of score to store in the transposition table
+    auto hash_flag = hash_flag_alpha;
+    auto best_move = Move{};
+    //Checking moves are found once per node without making them
+    auto check_info = board_state->get_check_info();
     //Loop over moves in move list
-    for (auto iCount = 0; iCount < move_list.get_num_moves(); iCount++)
+    for (auto iCount = 0; (iCount < move_list.get_num_moves()) || !moves_generated; iCount++)
     {
+        //Nothing searched so far cut off, generate and order the remaining moves
+        if (!moves_generated && (iCount == move_list.get_num_moves()))
+        {
+            add_remaining_moves(board_state, move_list);
+            moves_generated = true;
+            if (iCount == move_list.get_num_moves())
+                break;
+        }
+        Move move = move_list.get_move(iCount);
+        //Only search the root moves given by "searchmoves"
+        if ((ply_ == 0) && !is_search_move(move))
+            continue;
+        bool quiet_move = !move.get_move_capture_flag() && !move.get_move_promotion_type();
+        bool gives_check = board_state->gives_check(move, check_info);
+        //Late move pruning, at shallow depth only the first few quiet moves are worth searching
+        if (can_prune && quiet_move && !gives_check && (depth <= LATE_MOVE_PRUNING_DEPTH) &&
+            (moves_searched >= (LATE_MOVE_PRUNING_BASE + depth * depth) / (improving ? 1 : 2)))
+            continue;
+        //Quiet moves that give check are still searched
+        if (futile && (moves_searched > 0) && quiet_move && !gives_check)
+            continue;
         //Make copy of state
         auto copy_of_state = BoardstateCopy{};
         board_state->make_copy(copy_of_state);
+        stack.current_move = move;
+        stack.gives_check = gives_check;
+        stack.continuation_history = &continuation_history[move.get_move_piece()][move.get_move_target_square()];
         //Increment the number of moves in given branch traversed
         ply_++;
         //Make only legal moves
-        Move move = move_list.get_move(iCount);
         if (board_state->make_move(move,all_moves) == 0)
         {
             //Restore state for illegal move
@@ -140,6 +266,12 @@ int NegaMax::find_best_move(std::shared_ptr<Boardstate> board_state, int alpha,
         }
         //Increment legal moves
         legal_moves++;
+        //Remember the root move for progress reports
+        if (ply_ == 1)
+        {
+            root_move_ = move;
+            root_move_number_ = legal_moves;
+        }
         //Initialize the score
         int score = 0;
         //Find principle value using enhanced search
@@ -148,12 +280,22 @@ int NegaMax::find_best_move(std::shared_ptr<Boardstate> board_state, int alpha,
             score = -NegaMax::find_best_move(board_state, -beta, -alpha, depth - 1);
         }
         else {
+            //Late move reduction, moves sorted late are searched shallower first
+            auto reduction = 0;
             if ((moves_searched >= full_depth_moves) &&
                 (depth >= reduction_limit) &&
                 (is_king_in_check == false) &&
-                (move.get_move_capture_flag() == false) &&
-                (move.get_move_promotion_type() == 0)) {
-                score = -NegaMax::find_best_move(board_state, -alpha - 1, -alpha, depth - 2);
+                quiet_move && !gives_check) {
+                reduction = reductions[std::min(depth, MAX_PLY - 1)][moves_searched];
+                if (pv_node) reduction--;
+                if (!improving) reduction++;
+                //Moves that often fail high are reduced less, those that never do are reduced more
+                reduction -= get_quiet_history(move) / HISTORY_REDUCTION_DIVISOR;
+                //Always leave at least one ply to search
+                reduction = std::max(0, std::min(reduction, depth - 2));
+            }
+            if (reduction > 0) {
+                score = -NegaMax::find_best_move(board_state, -alpha - 1, -alpha, depth - 1 - reduction);
             }
             else {
                 score = alpha + 1;
@@ -176,23 +318,37 @@ int NegaMax::find_best_move(std::shared_ptr<Boardstate> board_state, int alpha,
         //Using Fail - Hard framework
         if (score >= beta)
         {
-            if (move.get_move_capture_flag() == 0)
+            if (quiet_move)
             {
                 //Set killer moves
-                killer_moves[SECOND_KILLER_MOVE_INDEX][ply_] = killer_moves[FIRST_KILLER_MOVE_INDEX][ply_];
-                killer_moves[FIRST_KILLER_MOVE_INDEX][ply_] = move;
+                stack.killers[SECOND_KILLER_MOVE_INDEX] = stack.killers[FIRST_KILLER_MOVE_INDEX];
+                stack.killers[FIRST_KILLER_MOVE_INDEX] = move;
+                //Set the counter move of the previous move
+                if ((ply_ > 0) && !search_stack[ply_ - ONE_PLY_BACK].current_move.is_no_move())
+                {
+                    auto &previous_move = search_stack[ply_ - ONE_PLY_BACK].current_move;
+                    counter_moves[previous_move.get_move_piece()][previous_move.get_move_target_square()] = move;
+                }
+                //Reward the cut off move and punish the quiet moves searched before it
+                auto bonus = std::min(HISTORY_BONUS_SCALE * depth * depth, HISTORY_BONUS_MAXIMUM);
+                update_quiet_histories(move, bonus);
+                for (auto quiet = 0; quiet < quiets_searched.get_num_moves(); quiet++)
+                {
+                    auto failed_move = quiets_searched.get_move(quiet);
+                    update_quiet_histories(failed_move, -bonus);
+                }
             }
+            TranspositionTable::store(board_state->get_hash_key(), depth, hash_flag_beta, beta, ply_, PackedMove{move});
             //Node fails high
             return beta;
         }
+        if (quiet_move)
+            quiets_searched.add_move(move);
         //If a better move is found
         if (score > alpha)
         {
-            if (move.get_move_capture_flag() == 0)
-            {
-                //Set history moves
-                history_moves[move.get_move_piece()][move.get_move_target_square()] += depth;
-            }
+            hash_flag = hash_flag_exact;
+            best_move = move;
             //Set new alpha
             alpha = score;
             //Write PV move to PV table
@@ -216,22 +372,39 @@ int NegaMax::find_best_move(std::shared_ptr<Boardstate> board_state, int alpha,
             return DRAW_SCORE;
         }
     }
+    TranspositionTable::store(board_state->get_hash_key(), depth, hash_flag, alpha, ply_, PackedMove{best_move});
     //Node (move) fails low
     return alpha;
 }
 
 //Searches captures only until quiet position with no more captures
-int NegaMax::quiescence_search(std::shared_ptr<Boardstate> board_state, int alpha, int beta)
+int NegaMax::quiescence_search(std::shared_ptr<Boardstate> board_state, int alpha, int beta, int static_eval)
 {
-    //Quick stop as needed
-    if((nodes_ & NODE_POLL_FREQ ) == 0) {
+    //Quick stop as needed, the clock is only read once the node budget is used up
+    if(gameTimer.poll_due(nodes_)) {
         // "listen" to the GUI/user input
-		gameTimer.communicate();
+		gameTimer.communicate(nodes_);
+        report_progress();
     }
+    //Unwind without searching once stopped
+    if (gameTimer.get_stopped())
+        return 0;
     //Increments nodes
     nodes_++;
-    //Find position evaluation
-    int evaluation = BasicEval::evaluate(board_state);
+    //Track the selective depth
+    if (ply_ > seldepth_)
+        seldepth_ = ply_;
+    //Hard node limit for reproducible searches
+    if ((node_limit_ != NO_NODE_LIMIT) && (nodes_ >= node_limit_))
+        gameTimer.set_stopped(true);
+    //Find position evaluation, unless the caller already has it
+    //Stand pat only needs to know where the evaluation lies relative to the window
+    int evaluation = (static_eval != NO_STATIC_EVAL) ? static_eval : BasicEval::evaluate(board_state, alpha, beta);
+    //Ensure that engine does not crash by searching at a depth that is too large
+    if (ply_ >= MAX_PLY)
+        return evaluation;
+    search_stack[ply_].static_eval = evaluation;
+    search_stack[ply_].in_check = false;
     //Using Fail - Hard framework
     if (evaluation >= beta)
     {
@@ -250,13 +423,26 @@ int NegaMax::quiescence_search(std::shared_ptr<Boardstate> board_state, int alph
     //Loop over moves in move list
     for (auto iCount = 0; iCount < move_list.get_num_moves(); iCount++)
     {
+        //Skip quiet moves and captures that lose material on the exchange
+        Move move = move_list.get_move(iCount);
+        if (!move.get_move_capture_flag())
+            continue;
+        //Delta pruning, even winning the captured piece leaves the score below alpha
+        if (pruning_enabled_[delta_pruning] && !move.get_move_promotion_type())
+        {
+            auto captured_piece = move.get_move_en_passant_flag() ? P :
+                                  board_state->get_piece_on_square(move.get_move_target_square());
+            if (evaluation + std::abs(BasicEval::material_scores[captured_piece]) + DELTA_MARGIN <= alpha)
+                continue;
+        }
+        if (!board_state->see(move, SEE_QUIESCENCE_THRESHOLD))
+            continue;
         //Make copy of state
         auto copy_of_state = BoardstateCopy{};
         board_state->make_copy(copy_of_state);
         //Increment the number of moves in given branch traversed
         ply_++;
         //Make only legal moves
-        Move move = move_list.get_move(iCount);
         if (board_state->make_move(move,captures_only) == 0)
         {
             //Restore state for illegal move
@@ -265,10 +451,13 @@ int NegaMax::quiescence_search(std::shared_ptr<Boardstate> board_state, int alph
             continue;
         }
         //Iterate to next node in tree
-        int score = -NegaMax::quiescence_search(board_state, -beta, -alpha);
+        int score = -NegaMax::quiescence_search(board_state, -beta, -alpha, NO_STATIC_EVAL);
         //Restore state
         ply_--;
         board_state->restore_copy(copy_of_state);
+        if (gameTimer.get_stopped()) {
+            return score;
+        }
         //Using Fail - Hard framework
         if (score >= beta)
         {
@@ -288,11 +477,35 @@ int NegaMax::nega_search(std::shared_ptr<Boardstate> board_state, int alpha, int
     //Reset all data used in search
     //reset_nodes();
     reset_ply();
+    root_depth_ = depth;
+    root_move_ = Move{};
+    root_move_number_ = 0;
     enable_following_PV();
     //Find best move
     return find_best_move(board_state, alpha, beta, depth);
 }
 
+void NegaMax::add_remaining_moves(std::shared_ptr<Boardstate> board_state, MoveList &move_list)
+{
+    auto num_searched = move_list.get_num_moves();
+    auto generated = MoveList{};
+    board_state->generate_moves(generated);
+    //Find principle variation
+    if (following_PV_)
+        enable_PV_scoring(generated);
+    //Order moves to increase alpha beta pruning speed
+    Search::sort_moves(board_state, generated);
+    for (auto iCount = 0; iCount < generated.get_num_moves(); iCount++)
+    {
+        auto move = generated.get_move(iCount);
+        auto already_searched = false;
+        for (auto searched = 0; searched < num_searched; searched++)
+            already_searched |= (move_list.get_move(searched) == move);
+        if (!already_searched)
+            move_list.add_move(move);
+    }
+}
+
 void NegaMax::enable_PV_scoring(MoveList move_list){
       disable_following_PV();
       for (auto iCount = 0; iCount < move_list.get_num_moves(); iCount++) {
@@ -311,6 +524,156 @@ Move NegaMax::get_best_move()
     return PV_table[BEST_MOVE_INDEX][BEST_MOVE_INDEX];
 }
 
+void NegaMax::set_node_limit(long long node_limit)
+{
+    node_limit_ = node_limit;
+}
+
+void NegaMax::set_search_moves(MoveList &search_moves)
+{
+    search_moves_ = search_moves;
+}
+
+void NegaMax::set_pruning(int pruning_type, bool enabled)
+{
+    pruning_enabled_[pruning_type] = enabled;
+}
+
+bool NegaMax::get_pruning(int pruning_type)
+{
+    return pruning_enabled_[pruning_type];
+}
+
+//History gravity, the bonus shrinks as the entry approaches the bound so entries stay within it
+static void apply_history_bonus(int &entry, int bonus)
+{
+    entry += bonus - entry * std::abs(bonus) / HISTORY_MAXIMUM;
+}
+
+void NegaMax::update_quiet_histories(Move &move, int bonus)
+{
+    auto piece = move.get_move_piece();
+    auto target_square = move.get_move_target_square();
+    apply_history_bonus(history_moves[piece][target_square], bonus);
+    for (auto plies_back : {ONE_PLY_BACK, TWO_PLIES_BACK})
+    {
+        if ((ply_ >= plies_back) && search_stack[ply_ - plies_back].continuation_history)
+            apply_history_bonus((*search_stack[ply_ - plies_back].continuation_history)[piece][target_square], bonus);
+    }
+}
+
+int NegaMax::get_quiet_history(Move &move)
+{
+    auto piece = move.get_move_piece();
+    auto target_square = move.get_move_target_square();
+    auto score = history_moves[piece][target_square];
+    for (auto plies_back : {ONE_PLY_BACK, TWO_PLIES_BACK})
+    {
+        if ((ply_ >= plies_back) && search_stack[ply_ - plies_back].continuation_history)
+            score += (*search_stack[ply_ - plies_back].continuation_history)[piece][target_square];
+    }
+    return score;
+}
+
+Move NegaMax::get_counter_move()
+{
+    if (ply_ == 0)
+        return Move{};
+    auto &previous_move = search_stack[ply_ - ONE_PLY_BACK].current_move;
+    if (previous_move.is_no_move())
+        return Move{};
+    return counter_moves[previous_move.get_move_piece()][previous_move.get_move_target_square()];
+}
+
+bool NegaMax::is_in_check(std::shared_ptr<Boardstate> board_state)
+{
+    return board_state->is_in_check();
+}
+
+//An empty "searchmoves" list allows every move
+bool NegaMax::is_search_move(Move &move)
+{
+    if (search_moves_.get_num_moves() == 0)
+        return true;
+    for (auto iCount = 0; iCount < search_moves_.get_num_moves(); iCount++)
+    {
+        auto search_move = search_moves_.get_move(iCount);
+        if (search_move == move)
+            return true;
+    }
+    return false;
+}
+
+//Sends depth, node and current root move information about once a second
+void NegaMax::report_progress()
+{
+    auto search_time = get_search_time();
+    if (search_time - last_report_time_ < PROGRESS_REPORT_INTERVAL)
+        return;
+    last_report_time_ = search_time;
+    UCI_Link::print_progress_info(root_depth_, seldepth_, nodes_, search_time,
+                                  root_move_, root_move_number_);
+}
+
+void NegaMax::start_search_clock()
+{
+    search_start_time_ = UCITimer::get_time_ms();
+    last_report_time_ = 0;
+    seldepth_ = 0;
+}
+
+long long NegaMax::get_search_time()
+{
+    return UCITimer::get_time_ms() - search_start_time_;
+}
+
+int NegaMax::get_seldepth()
+{
+    return seldepth_;
+}
+
+void NegaMax::age_search_tables()
+{
+    for (auto piece = 0; piece < NUM_PIECE_TYPES; piece++)
+    {
+        for (auto square = 0; square < NUM_SQUARES; square++)
+        {
+            history_moves[piece][square] /= HISTORY_DECAY;
+            for (auto &previous_piece : continuation_history[piece][square])
+                for (auto &entry : previous_piece)
+                    entry /= HISTORY_DECAY;
+        }
+    }
+    //Two plies have been played since the last search, ply 2 then is ply 0 now
+    for (auto ply = 0; ply < MAX_PLY; ply++)
+    {
+        auto old_ply = ply + KILLER_SHIFT;
+        search_stack[ply].killers[FIRST_KILLER_MOVE_INDEX] = (old_ply < MAX_PLY) ?
+                                              search_stack[old_ply].killers[FIRST_KILLER_MOVE_INDEX] : Move{};
+        search_stack[ply].killers[SECOND_KILLER_MOVE_INDEX] = (old_ply < MAX_PLY) ?
+                                              search_stack[old_ply].killers[SECOND_KILLER_MOVE_INDEX] : Move{};
+        search_stack[ply].static_eval = NO_STATIC_EVAL;
+        search_stack[ply].current_move = Move{};
+        search_stack[ply].gives_check = false;
+        search_stack[ply].continuation_history = nullptr;
+    }
+    memset(PV_table, 0, sizeof(PV_table));
+    memset(PV_length, 0, sizeof(PV_length));
+    TranspositionTable::new_search();
+}
+
+void NegaMax::clear_search_tables()
+{
+    for (auto &stack : search_stack)
+        stack = SearchStack{};
+    memset(history_moves, 0, sizeof(history_moves));
+    memset(continuation_history, 0, sizeof(continuation_history));
+    memset(counter_moves, 0, sizeof(counter_moves));
+    memset(PV_table, 0, sizeof(PV_table));
+    memset(PV_length, 0, sizeof(PV_length));
+    TranspositionTable::clear();
+}
+
 void NegaMax::reset_nodes()
 {
     nodes_ = 0;
@@ -371,30 +734,38 @@ std::string Search::search_position(std::shared_ptr<Boardstate> board_state, int
     std::string move_string = "";
     auto alpha = MINIMUM_SCORE;
     auto beta = MAXIMIM_SCORE;
+    auto best_move = Move{};
     NegaMax::gameTimer.set_stopped(false);
+    NegaMax::reset_nodes();
+    NegaMax::start_search_clock();
+    NegaMax::gameTimer.start_polling(NegaMax::get_nodes());
+    //Keeps the search within the accumulator stack
+    board_state->reset_accumulators();
     //Add searches as needed
     switch (search_type)
     {
     case (RandomSearch):
         score = RandomEngine::find_random_move(board_state);
-        UCI_Link::set_search_info(score,1,0);
+        UCI_Link::set_search_info(score,1,1,0,0);
         move_string = RandomEngine::get_best_move().get_move_UCI();
         return move_string;
     case (NegaMaxSearch):
         //implementing iterative deepening
         NegaMax::disable_following_PV();
         NegaMax::disable_evaluate_PV();
-        //Clear Move lists
-        memset(NegaMax::killer_moves, 0, sizeof(NegaMax::killer_moves));
-        memset(NegaMax::history_moves, 0, sizeof(NegaMax::history_moves));
-        memset(NegaMax::PV_table, 0, sizeof(NegaMax::PV_table));
-        memset(NegaMax::PV_length, 0, sizeof(NegaMax::PV_length));
+        //Keep what was learned in the previous search
+        NegaMax::age_search_tables();
         for (int current_depth = 1; current_depth <= depth; current_depth++)
         {
             if (NegaMax::gameTimer.get_stopped()) {
                 break;
             }
             score = NegaMax::nega_search(board_state, alpha, beta, current_depth);
+            //Discard an unfinished iteration
+            if (NegaMax::gameTimer.get_stopped()) {
+                break;
+            }
+            best_move = NegaMax::get_best_move();
             if ((score <= alpha) || (score >= beta)) {
                 alpha = MINIMUM_SCORE;
                 beta = MAXIMIM_SCORE;
@@ -402,11 +773,14 @@ std::string Search::search_position(std::shared_ptr<Boardstate> board_state, int
             }
             alpha = score - ASPIRATION_WINDOW_SCORE;
             beta = score + ASPIRATION_WINDOW_SCORE;
-            UCI_Link::set_search_info(score,current_depth,NegaMax::get_nodes());
+            UCI_Link::set_search_info(score,current_depth,NegaMax::get_seldepth(),
+                                      NegaMax::get_nodes(),NegaMax::get_search_time());
             UCI_Link::print_search_info(NegaMaxSearch);
         }
-        //returning best move
-        move_string = NegaMax::get_best_move().get_move_UCI();
+        //returning best move of the last completed iteration
+        if (best_move.is_no_move())
+            best_move = NegaMax::get_best_move();
+        move_string = best_move.get_move_UCI();
         return move_string;
     default:
         return move_string;
@@ -6,6 +6,7 @@
 
 #include "../BoardState.h"
 #include "../Evaluation/BasicEval.h"
+#include "TranspositionTable.h"
 #include "../../GUI-code/UCI/UCI.h"
 #include "../../GUI-code/UCI/UCITimer.h"
 
@@ -26,11 +27,35 @@
  constexpr auto NUM_SQUARES = 64;
  constexpr auto NUM_PIECE_TYPES = 12;
  constexpr auto NUM_KILLER_IDS = 2;
+ constexpr auto NO_STATIC_EVAL = -50000;
+
+ //continuation_history[piece][target] of the move played, scores the next move by its own piece and target
+ using ContinuationHistory = int[NUM_PIECE_TYPES][NUM_SQUARES];
+
+ //Everything the search remembers about the node at one ply
+ struct SearchStack
+ {
+    //Static evaluation of the node, NO_STATIC_EVAL when in check
+    int static_eval = NO_STATIC_EVAL;
+    bool in_check = false;
+    //Move being searched from this node, no move while the null move is searched
+    Move current_move;
+    //Whether current_move checks the opponent, the child node takes it as its in_check
+    bool gives_check = false;
+    Move killers[NUM_KILLER_IDS];
+    //Continuation history of current_move, nullptr for the null move
+    ContinuationHistory *continuation_history = nullptr;
+ };
+
+ //Pruning techniques that can be switched off with UCI options
+ enum {futility_pruning = 0, reverse_futility_pruning, razoring, delta_pruning, NUM_PRUNING_TYPES};
 
  class NegaMax
  {
  public:
     static int nega_search(std::shared_ptr<Boardstate> board_state, int alpha, int beta, int depth);
+    //Fills the late move reduction table, called once at start up
+    static void init_reductions();
     static void reset_nodes();
     static void reset_ply();
     static void disable_following_PV();
@@ -40,14 +65,33 @@
     static bool get_following_PV();
     static bool get_evaluate_PV();
     static int get_ply();
+    static int get_seldepth();
     static long long get_nodes();
+    static long long get_search_time();
+    static void start_search_clock();
     static Move get_best_move();
+    //Search limits set by the UCI "go" command
+    static void set_node_limit(long long node_limit);
+    static void set_search_moves(MoveList &search_moves);
+    static void set_pruning(int pruning_type, bool enabled);
+    static bool get_pruning(int pruning_type);
+    //Prepares the tables for the next search, history decays and killers move up two plies
+    static void age_search_tables();
+    //Forgets everything learned, used on "ucinewgame"
+    static void clear_search_tables();
 
     //Move ordering for negamax
-    //killer_moves[id][ply] //Can increase ply for greater depth search
-    static Move killer_moves[NUM_KILLER_IDS][MAX_PLY];
-    //killer_moves[piece][square]
+    //search_stack[ply], killer moves are kept per ply on the stack
+    static SearchStack search_stack[MAX_PLY];
+    //history_moves[piece][square]
     static int history_moves[NUM_PIECE_TYPES][NUM_SQUARES];
+    //continuation_history[previous piece][previous target][piece][target]
+    static ContinuationHistory continuation_history[NUM_PIECE_TYPES][NUM_SQUARES];
+    //counter_moves[previous piece][previous target], the quiet move that last refuted the previous move
+    static Move counter_moves[NUM_PIECE_TYPES][NUM_SQUARES];
+    //Sum of the history and the continuation histories one and two plies back
+    static int get_quiet_history(Move &move);
+    static Move get_counter_move();
     /*
       ================================
             Triangular PV table
@@ -68,14 +112,32 @@
 
       5    0    0    0    0    0    m6
     */
-    static int PV_length[MAX_PLY];
-    static Move PV_table[MAX_PLY][MAX_PLY];
+    //One row more than the search can reach, a node at MAX_PLY - 1 reads its child's length
+    static int PV_length[MAX_PLY + 1];
+    static Move PV_table[MAX_PLY + 1][MAX_PLY];
+    //Best move from the transposition table for the node at each ply
+    static Move hash_moves[MAX_PLY];
     static UCITimer gameTimer;
  private:
-    static int quiescence_search(std::shared_ptr<Boardstate> board_state, int alpha, int beta);
+    static int quiescence_search(std::shared_ptr<Boardstate> board_state, int alpha, int beta, int static_eval);
     static int find_best_move(std::shared_ptr<Boardstate> board_state, int alpha, int beta, int depth);
+    static bool is_search_move(Move &move);
+    //Appends the generated moves, ordered, that are not already in the list
+    static void add_remaining_moves(std::shared_ptr<Boardstate> board_state, MoveList &move_list);
+    static bool is_in_check(std::shared_ptr<Boardstate> board_state);
+    static void update_quiet_histories(Move &move, int bonus);
+    static void report_progress();
     static long long nodes_;
+    static long long node_limit_;
+    static MoveList search_moves_;
+    static bool pruning_enabled_[NUM_PRUNING_TYPES];
     static int ply_;
+    static int seldepth_;
+    static int root_depth_;
+    static Move root_move_;
+    static int root_move_number_;
+    static long long search_start_time_;
+    static long long last_report_time_;
     static bool following_PV_;
     static bool evaluate_PV_;
     //static Move best_move;
@@ -83,6 +145,8 @@
     static void enable_PV_scoring(MoveList move_list);
     static int reduction_limit;
     static int full_depth_moves;
+    //reductions[depth][moves searched] in plies, grows with the log of both
+    static int reductions[MAX_PLY][MAX_MOVES_PER_POS];
  };
 
  //Expand types of search as needed
@@ -0,0 +1,117 @@
+#include "TranspositionTable.h"
+
+#include <algorithm>
+
+constexpr auto BYTES_PER_MEGABYTE = 1024ull * 1024ull;
+constexpr auto HASHFULL_SAMPLE = 1000;
+constexpr auto ENTRY_KEY_SHIFT = 32;
+
+static_assert(sizeof(HashEntry) == 16, "hash entries should pack four to a cache line");
+
+std::vector<HashEntry> TranspositionTable::table_(TranspositionTable::entries_for(TranspositionTable::DEFAULT_SIZE_MB));
+bitboard TranspositionTable::mask_{TranspositionTable::entries_for(TranspositionTable::DEFAULT_SIZE_MB) - 1};
+unsigned char TranspositionTable::generation_{0};
+
+size_t TranspositionTable::entries_for(int megabytes)
+{
+    auto entries = size_t{1};
+    while (entries * 2 * sizeof(HashEntry) <= megabytes * BYTES_PER_MEGABYTE)
+        entries *= 2;
+    return entries;
+}
+
+void TranspositionTable::resize(int megabytes)
+{
+    if (megabytes < MINIMUM_SIZE_MB)
+        megabytes = MINIMUM_SIZE_MB;
+    if (megabytes > MAXIMUM_SIZE_MB)
+        megabytes = MAXIMUM_SIZE_MB;
+    table_.assign(entries_for(megabytes), HashEntry{});
+    mask_ = table_.size() - 1;
+    generation_ = 0;
+}
+
+void TranspositionTable::clear()
+{
+    std::fill(table_.begin(), table_.end(), HashEntry{});
+    generation_ = 0;
+}
+
+//Generation 0 is only ever given to entries, so it is older than every search
+constexpr unsigned char OLDEST_GENERATION = 0;
+
+void TranspositionTable::new_search()
+{
+    //The counter wraps after 255 searches. Entries that old would look current again,
+    //so every entry is marked oldest and the numbering starts over.
+    if (++generation_ == OLDEST_GENERATION)
+    {
+        for (auto &entry : table_)
+            entry.generation = OLDEST_GENERATION;
+        generation_++;
+    }
+}
+
+HashEntry& TranspositionTable::get_entry(bitboard key)
+{
+    return table_[key & mask_];
+}
+
+static inline uint32_t entry_key(bitboard key)
+{
+    return static_cast<uint32_t>(key >> ENTRY_KEY_SHIFT);
+}
+
+int TranspositionTable::probe(bitboard key, int depth, int alpha, int beta, int ply, PackedMove &best_move)
+{
+    auto &entry = get_entry(key);
+    if (entry.key != entry_key(key))
+        return NO_HASH_ENTRY;
+    //Keep the move for ordering even if the score cannot be used
+    best_move = entry.best_move;
+    if (entry.depth < depth)
+        return NO_HASH_ENTRY;
+    //Mate scores are stored as distance from this node, convert back to distance from root
+    auto score = entry.score;
+    if (score < -HASH_MATE_BOUND) score += ply;
+    if (score > HASH_MATE_BOUND) score -= ply;
+    if (entry.flag == hash_flag_exact)
+        return score;
+    if ((entry.flag == hash_flag_alpha) && (score <= alpha))
+        return alpha;
+    if ((entry.flag == hash_flag_beta) && (score >= beta))
+        return beta;
+    return NO_HASH_ENTRY;
+}
+
+void TranspositionTable::store(bitboard key, int depth, int flag, int score, int ply, PackedMove best_move)
+{
+    auto &entry = get_entry(key);
+    auto stored_key = entry_key(key);
+    //Entries of an older search are always replaced, otherwise prefer the deeper search
+    if ((entry.generation == generation_) && (entry.key != stored_key) && (entry.depth > depth))
+        return;
+    if (score < -HASH_MATE_BOUND) score -= ply;
+    if (score > HASH_MATE_BOUND) score += ply;
+    //Do not lose the best move of an earlier search of this position
+    if (best_move.is_no_move() && (entry.key == stored_key))
+        best_move = entry.best_move;
+    entry.key = stored_key;
+    entry.best_move = best_move;
+    entry.score = score;
+    entry.depth = depth;
+    entry.flag = flag;
+    entry.generation = generation_;
+}
+
+int TranspositionTable::hashfull()
+{
+    auto used = 0;
+    auto sample = std::min(static_cast<size_t>(HASHFULL_SAMPLE), table_.size());
+    for (size_t iCount = 0; iCount < sample; iCount++)
+    {
+        if ((table_[iCount].key != 0u) && (table_[iCount].generation == generation_))
+            used++;
+    }
+    return used * HASHFULL_SAMPLE / sample;
+}
@@ -0,0 +1,65 @@
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include <vector>
+#include <cstdint>
+
+#include "../BitBoard.h"
+#include "../Move.h"
+
+/** \file TranspositionTable.h
+    \brief Contains the transposition table used by the search
+ */
+
+//Type of score stored in a hash entry
+enum { hash_flag_exact = 0, hash_flag_alpha, hash_flag_beta };
+
+//Returned by probe() when the entry cannot be used for a cut off
+constexpr int NO_HASH_ENTRY = 100000;
+//Scores beyond this are mate scores and are stored relative to the node
+constexpr int HASH_MATE_BOUND = 48000;
+
+//16 bytes, four entries share a cache line
+class HashEntry
+{
+public:
+    //Upper half of the position key, the lower half already picked the slot
+    uint32_t key = 0u;
+    int score = 0;
+    //Moves from a key collision are caught by Boardstate::is_pseudo_legal()
+    PackedMove best_move = PackedMove{};
+    signed char depth = 0;
+    unsigned char flag = hash_flag_exact;
+    //Search generation the entry was last written in
+    unsigned char generation = 0;
+};
+
+//Entries are never cleared between searches. Every search bumps the
+//generation and entries from older generations are replaced first.
+//When the generation wraps every entry is aged once, so an old entry is
+//never mistaken for one written in the current search. The number of entries
+//is a power of two so the index is the low bits of the key.
+class TranspositionTable
+{
+public:
+    static void resize(int megabytes);
+    static void clear();
+    static void new_search();
+    //Returns a score usable at this node or NO_HASH_ENTRY, best_move is always filled in on a hit
+    static int probe(bitboard key, int depth, int alpha, int beta, int ply, PackedMove &best_move);
+    static void store(bitboard key, int depth, int flag, int score, int ply, PackedMove best_move);
+    //Permill of the table written in the current search
+    static int hashfull();
+    static constexpr int DEFAULT_SIZE_MB = 16;
+    static constexpr int MINIMUM_SIZE_MB = 1;
+    static constexpr int MAXIMUM_SIZE_MB = 1024;
+private:
+    //Largest power of two number of entries that fits in the given size
+    static size_t entries_for(int megabytes);
+    static HashEntry& get_entry(bitboard key);
+    static std::vector<HashEntry> table_;
+    static bitboard mask_;
+    static unsigned char generation_;
+};
+
+#endif
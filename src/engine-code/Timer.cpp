@@ -2,20 +2,17 @@
 #include <iostream>
 using namespace std;
 
-int Timer::get_time_milliseconds()
+constexpr auto NANOSECONDS_PER_MILLISECOND = 1000000ll;
+
+long long Timer::get_time_nanoseconds()
 {
-    #ifdef WIN64
-        return GetTickCount();
-    #else
-        struct timeval time_value;
-        gettimeofday(&time_value, NULL);
-        return time_value.tv_sec * 1000 + time_value.tv_usec / 1000;
-    #endif // WIN64
+    return chrono::duration_cast<chrono::nanoseconds>(
+           chrono::steady_clock::now().time_since_epoch()).count();
 }
 
-int Timer::startTime{0};
-int Timer::endTime{0};
-int Timer::elapsed{0};
+long long Timer::startTime{0};
+long long Timer::endTime{0};
+long long Timer::elapsed{0};
 bool Timer::paused{true};
 
 //Resets the elapsed time to zero and pauses timer
@@ -30,7 +27,7 @@ void Timer::start()
 {
     if (paused)
     {
-        startTime = get_time_milliseconds();
+        startTime = get_time_nanoseconds();
         paused = false;
     }
 }
@@ -40,7 +37,7 @@ void Timer::stop()
 {
     if (!paused)
     {
-        endTime = get_time_milliseconds();
+        endTime = get_time_nanoseconds();
         elapsed = elapsed + (endTime - startTime);
         paused = true;
     }
@@ -52,12 +49,22 @@ void Timer::display()
 {
     if (paused)
     {
-         cout << "Total time is: " << elapsed << " milliseconds" <<endl;
+         cout << "Total time is: " << elapsed / NANOSECONDS_PER_MILLISECOND << " milliseconds" <<endl;
+    }
+}
+
+//Returns the recorded elapsed time of the timer in milliseconds
+long long Timer::readTime()
+{
+    if (paused)
+    {
+        return elapsed / NANOSECONDS_PER_MILLISECOND;
     }
+    return 0;
 }
 
-//Returns the recorded elapsed time of the timer
-int Timer::readTime()
+//Returns the recorded elapsed time of the timer in nanoseconds
+long long Timer::readTimeNanoseconds()
 {
     if (paused)
     {
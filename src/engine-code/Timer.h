@@ -5,13 +5,10 @@
     \brief Contains multiplatform timer
  */
 
-#ifdef WIN64
-    #include <windows.h>
-#else
-    #include <sys/time.h>
-#endif // WIN64
+#include <chrono>
 
-//NOTE NOT YET TESTED ON LINUX OR MAC OS
+//Uses std::chrono::steady_clock which is monotonic and will not jump when
+//the system clock is adjusted. Times are stored as 64-bit nanoseconds.
 class Timer
 {
 public:
@@ -19,15 +16,14 @@ public:
     static void stop();
     static void reset();
     static void display();
-    static int readTime();
+    static long long readTime();
+    static long long readTimeNanoseconds();
+    static long long get_time_nanoseconds();
 private:
-    static int get_time_milliseconds();
-    static int startTime;
-    static int endTime;
-    static int elapsed;
+    static long long startTime;
+    static long long endTime;
+    static long long elapsed;
     static bool paused;
 };
 
 #endif
-
-
@@ -0,0 +1,84 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include "BitBoard.h"
+
+/** \file Zobrist.h
+    \brief Contains Zobrist hashing keys
+ */
+
+//Random keys used to hash a board state into a single 64-bit number.
+//The key of a position is the XOR of the keys of all its features, thus
+//a move only has to XOR in and out the features it changes.
+//The keys are generated at compile time and are read only data.
+namespace Zobrist
+{
+    constexpr auto NUM_PIECE_TYPES = 12;
+    constexpr auto NUM_SQUARES = 64;
+    constexpr auto NUM_CASTLING_STATES = 16;
+
+    //Fixed seed so that keys are the same on every build
+    constexpr unsigned int ZOBRIST_SEED = 1804289383u;
+
+    class Keys
+    {
+    public:
+        //piece_keys[piece][square]
+        bitboard piece_keys[NUM_PIECE_TYPES][NUM_SQUARES] = {};
+        //en_passant_keys[square]
+        bitboard en_passant_keys[NUM_SQUARES] = {};
+        //castling_keys[castling_rights]
+        bitboard castling_keys[NUM_CASTLING_STATES] = {};
+        //XOR'd in when black is to move
+        bitboard side_key = bitboard{};
+    };
+
+    //Same xorshift sequence as PsuedoRandom, which cannot be used in constant expressions
+    constexpr unsigned int next_random_32Bit(unsigned int &state)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    constexpr bitboard next_random_64Bit(unsigned int &state)
+    {
+        auto randNum1 = bitboard{next_random_32Bit(state) & 0xFFFF};
+        auto randNum2 = bitboard{next_random_32Bit(state) & 0xFFFF};
+        auto randNum3 = bitboard{next_random_32Bit(state) & 0xFFFF};
+        auto randNum4 = bitboard{next_random_32Bit(state) & 0xFFFF};
+        return randNum1 | (randNum2 << 16) | (randNum3 << 32) | (randNum4 << 48);
+    }
+
+    constexpr Keys generate_keys()
+    {
+        auto keys = Keys{};
+        auto state = ZOBRIST_SEED;
+        for (auto piece = 0; piece < NUM_PIECE_TYPES; piece++)
+        {
+            for (auto square = 0; square < NUM_SQUARES; square++)
+            {
+                keys.piece_keys[piece][square] = next_random_64Bit(state);
+            }
+        }
+        for (auto square = 0; square < NUM_SQUARES; square++)
+        {
+            keys.en_passant_keys[square] = next_random_64Bit(state);
+        }
+        for (auto castle = 0; castle < NUM_CASTLING_STATES; castle++)
+        {
+            keys.castling_keys[castle] = next_random_64Bit(state);
+        }
+        keys.side_key = next_random_64Bit(state);
+        return keys;
+    }
+
+    inline constexpr Keys keys = generate_keys();
+    inline constexpr const auto &piece_keys = keys.piece_keys;
+    inline constexpr const auto &en_passant_keys = keys.en_passant_keys;
+    inline constexpr const auto &castling_keys = keys.castling_keys;
+    inline constexpr const auto &side_key = keys.side_key;
+}
+
+#endif
@@ -0,0 +1,259 @@
+#include "doctest.h"
+
+#include <memory>
+#include <random>
+#include <string>
+
+#include "../engine-code/BoardState.h"
+#include "../engine-code/Evaluation/NNUE.h"
+
+constexpr auto START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+constexpr auto KIWIPETE_FEN = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+constexpr auto NO_PIECE = -1;
+constexpr auto PLAYOUTS = 200;
+constexpr auto PLAYOUT_PLIES = 80;
+constexpr auto SHUFFLE_PLIES = 1500;
+
+static std::shared_ptr<Boardstate> board_from_fen(const std::string &fen)
+{
+    auto board_state = std::make_shared<Boardstate>();
+    board_state->FEN_parse(fen);
+    return board_state;
+}
+
+//Plays source to target, fails the test if the move is not legal
+static void play(std::shared_ptr<Boardstate> board_state, int source, int target, int promotion_piece = 0)
+{
+    auto move = board_state->build_move(source, target, promotion_piece);
+    REQUIRE(board_state->is_pseudo_legal(move));
+    REQUIRE(board_state->make_move(move, all_moves));
+}
+
+TEST_CASE("is_pseudo_legal accepts a legal move and rejects the wrong piece")
+{
+    auto board_state = board_from_fen(START_FEN);
+    auto knight_move = board_state->build_move(g1, f3, 0);
+    CHECK(knight_move.get_move_piece() == N);
+    CHECK(board_state->is_pseudo_legal(knight_move));
+    //Same squares with a bishop that is not on g1
+    auto wrong_piece = Move{g1, f3, B, 0, false, false, false, false};
+    CHECK_FALSE(board_state->is_pseudo_legal(wrong_piece));
+    //Black pieces cannot move while white is to move
+    auto wrong_side = board_state->build_move(g8, f6, 0);
+    CHECK_FALSE(board_state->is_pseudo_legal(wrong_side));
+    //Capture flag on a quiet move
+    auto false_capture = Move{g1, f3, N, 0, true, false, false, false};
+    CHECK_FALSE(board_state->is_pseudo_legal(false_capture));
+    auto no_move = Move{};
+    CHECK_FALSE(board_state->is_pseudo_legal(no_move));
+}
+
+TEST_CASE("is_pseudo_legal rejects blocked sliders and pawn pushes")
+{
+    auto board_state = board_from_fen(START_FEN);
+    auto blocked_bishop = Move{c1, g5, B, 0, false, false, false, false};
+    CHECK_FALSE(board_state->is_pseudo_legal(blocked_bishop));
+    auto blocked_rook = Move{a1, a3, R, 0, false, false, false, false};
+    CHECK_FALSE(board_state->is_pseudo_legal(blocked_rook));
+    play(board_state, d2, d4);
+    play(board_state, d7, d5);
+    auto open_bishop = board_state->build_move(c1, g5, 0);
+    CHECK(board_state->is_pseudo_legal(open_bishop));
+    //The pawn on d5 blocks both the single and the double push
+    auto blocked_push = board_state->build_move(d4, d5, 0);
+    CHECK_FALSE(board_state->is_pseudo_legal(blocked_push));
+    auto late_double_push = Move{d4, d6, P, 0, false, true, false, false};
+    CHECK_FALSE(board_state->is_pseudo_legal(late_double_push));
+}
+
+TEST_CASE("is_pseudo_legal checks castling through and out of check")
+{
+    auto board_state = board_from_fen("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1");
+    auto king_side = board_state->build_move(e1, g1, 0);
+    auto queen_side = board_state->build_move(e1, c1, 0);
+    CHECK(king_side.get_move_castling_flag());
+    CHECK(board_state->is_pseudo_legal(king_side));
+    CHECK(board_state->is_pseudo_legal(queen_side));
+    //A rook on f8 covers f1, the king would pass through check
+    board_state->FEN_parse("r3kr2/8/8/8/8/8/8/R3K2R w KQq - 0 1");
+    king_side = board_state->build_move(e1, g1, 0);
+    queen_side = board_state->build_move(e1, c1, 0);
+    CHECK_FALSE(board_state->is_pseudo_legal(king_side));
+    CHECK(board_state->is_pseudo_legal(queen_side));
+    //No castling out of check
+    board_state->FEN_parse("r3k2r/8/8/8/8/8/8/R3K2r w Qkq - 0 1");
+    queen_side = board_state->build_move(e1, c1, 0);
+    CHECK_FALSE(board_state->is_pseudo_legal(queen_side));
+    //No castling without the right
+    board_state->FEN_parse("r3k2r/8/8/8/8/8/8/R3K2R w Qkq - 0 1");
+    king_side = board_state->build_move(e1, g1, 0);
+    CHECK_FALSE(board_state->is_pseudo_legal(king_side));
+}
+
+TEST_CASE("build_move and is_pseudo_legal handle en passant")
+{
+    auto board_state = board_from_fen(START_FEN);
+    play(board_state, e2, e4);
+    play(board_state, a7, a6);
+    play(board_state, e4, e5);
+    play(board_state, d7, d5);
+    auto en_passant = board_state->build_move(e5, d6, 0);
+    CHECK(en_passant.get_move_en_passant_flag());
+    CHECK(en_passant.get_move_capture_flag());
+    CHECK(board_state->is_pseudo_legal(en_passant));
+    REQUIRE(board_state->make_move(en_passant, all_moves));
+    CHECK(board_state->get_piece_on_square(d6) == P);
+    CHECK(board_state->get_piece_on_square(d5) == NO_PIECE);
+    //The right is gone one move later
+    board_state->FEN_parse("rnbqkbnr/1pp1pppp/p7/3pP3/8/8/PPPP1PPP/RNBQKBNR w KQkq - 0 3");
+    auto stale_en_passant = Move{e5, d6, P, 0, true, false, true, false};
+    CHECK_FALSE(board_state->is_pseudo_legal(stale_en_passant));
+}
+
+TEST_CASE("Every generated move is pseudo legal and survives packing")
+{
+    std::mt19937 generator(1u);
+    auto board_state = std::make_shared<Boardstate>();
+    for (auto playout = 0; playout < PLAYOUTS; playout++)
+    {
+        board_state->FEN_parse((playout % 2) ? KIWIPETE_FEN : START_FEN);
+        for (auto ply = 0; ply < PLAYOUT_PLIES; ply++)
+        {
+            MoveList move_list;
+            board_state->generate_moves(move_list);
+            if (move_list.get_num_moves() == 0)
+                break;
+            for (auto index = 0; index < move_list.get_num_moves(); index++)
+            {
+                auto move = move_list.get_move(index);
+                auto rebuilt = board_state->build_move(PackedMove{move});
+                CHECK(board_state->is_pseudo_legal(move));
+                CHECK(rebuilt == move);
+            }
+            auto move = move_list.get_move(generator() % move_list.get_num_moves());
+            board_state->make_move(move, all_moves);
+        }
+    }
+}
+
+TEST_CASE("perft matches the standard positions")
+{
+    CHECK(board_from_fen(START_FEN)->perft(4) == 197281);
+    CHECK(board_from_fen(KIWIPETE_FEN)->perft(3) == 97862);
+    CHECK(board_from_fen("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1")->perft(4) == 43238);
+    CHECK(board_from_fen("r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1")->perft(3) == 9467);
+    CHECK(board_from_fen("rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8")->perft(3) == 62379);
+    CHECK(board_from_fen("r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10")->perft(3) ==
+          89890);
+}
+
+TEST_CASE("Incremental hash keys match keys computed from scratch")
+{
+    std::mt19937 generator(2u);
+    auto board_state = std::make_shared<Boardstate>();
+    for (auto playout = 0; playout < PLAYOUTS; playout++)
+    {
+        board_state->FEN_parse((playout % 2) ? KIWIPETE_FEN : START_FEN);
+        for (auto ply = 0; ply < PLAYOUT_PLIES; ply++)
+        {
+            MoveList move_list;
+            board_state->generate_moves(move_list);
+            if (move_list.get_num_moves() == 0)
+                break;
+            auto move = move_list.get_move(generator() % move_list.get_num_moves());
+            if (!board_state->make_move(move, all_moves))
+                continue;
+            REQUIRE(board_state->get_hash_key() == board_state->generate_hash_key());
+            REQUIRE(board_state->get_pawn_hash_key() == board_state->generate_pawn_hash_key());
+            REQUIRE(board_state->get_psqt_score() == board_state->generate_psqt_score());
+            REQUIRE(board_state->get_game_phase() == board_state->generate_game_phase());
+        }
+    }
+}
+
+TEST_CASE("Hash keys do not depend on the move order")
+{
+    auto board_state = board_from_fen(START_FEN);
+    play(board_state, g1, f3);
+    play(board_state, g8, f6);
+    play(board_state, b1, c3);
+    auto transposed = board_from_fen(START_FEN);
+    play(transposed, b1, c3);
+    play(transposed, g8, f6);
+    play(transposed, g1, f3);
+    CHECK(board_state->get_hash_key() == transposed->get_hash_key());
+    //Reached from a FEN instead of by moves
+    auto parsed = board_from_fen("rnbqkb1r/pppppppp/5n2/8/8/2N2N2/PPPPPPPP/R1BQKB1R b KQkq - 3 2");
+    CHECK(board_state->get_hash_key() == parsed->get_hash_key());
+    //Castling rights and side to move change the key
+    auto no_castling = board_from_fen("rnbqkb1r/pppppppp/5n2/8/8/2N2N2/PPPPPPPP/R1BQKB1R b kq - 3 2");
+    auto white_to_move = board_from_fen("rnbqkb1r/pppppppp/5n2/8/8/2N2N2/PPPPPPPP/R1BQKB1R w KQkq - 3 2");
+    CHECK(board_state->get_hash_key() != no_castling->get_hash_key());
+    CHECK(board_state->get_hash_key() != white_to_move->get_hash_key());
+}
+
+TEST_CASE("Repetitions are found after more moves than the table holds")
+{
+    auto board_state = board_from_fen("8/8/8/4k3/8/8/8/4K2N w - - 0 1");
+    const int shuffle[][2] = {{h1, g3}, {e5, e6}, {g3, h1}, {e6, e5}};
+    auto misses = 0;
+    for (auto ply = 0; ply < SHUFFLE_PLIES; ply++)
+    {
+        play(board_state, shuffle[ply % 4][0], shuffle[ply % 4][1]);
+        if ((ply >= 3) && !board_state->is_repetition())
+            misses++;
+    }
+    CHECK(SHUFFLE_PLIES > MAX_GAME_PLY);
+    CHECK(misses == 0);
+}
+
+TEST_CASE("see resolves the exchange on the target square")
+{
+    //Undefended pawn
+    auto board_state = board_from_fen("1k1r4/1pp4p/p7/4p3/8/P5P1/1PP4P/2K1R3 w - - 0 1");
+    auto rook_takes_pawn = board_state->build_move(e1, e5, 0);
+    CHECK(board_state->see(rook_takes_pawn, 0));
+    CHECK(board_state->see(rook_takes_pawn, 100));
+    CHECK_FALSE(board_state->see(rook_takes_pawn, 101));
+    //Pawn defended by a knight behind a defended knight
+    board_state->FEN_parse("1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3 w - - 0 1");
+    auto knight_takes_pawn = board_state->build_move(d3, e5, 0);
+    CHECK_FALSE(board_state->see(knight_takes_pawn, 0));
+    CHECK(board_state->see(knight_takes_pawn, -200));
+    //Quiet queen move to a square the c8 bishop covers, and an even pawn trade
+    board_state->FEN_parse(START_FEN);
+    play(board_state, e2, e4);
+    play(board_state, d7, d5);
+    auto queen_to_attacked = board_state->build_move(d1, g4, 0);
+    CHECK_FALSE(board_state->see(queen_to_attacked, 0));
+    auto queen_to_safe = board_state->build_move(d1, f3, 0);
+    CHECK(board_state->see(queen_to_safe, 0));
+    auto pawn_takes_pawn = board_state->build_move(e4, d5, 0);
+    CHECK(board_state->see(pawn_takes_pawn, 0));
+    CHECK_FALSE(board_state->see(pawn_takes_pawn, 1));
+    //Queen capture of a pawn defended by a pawn loses the queen
+    board_state->FEN_parse("4k3/8/2p5/3p4/8/8/3Q4/4K3 w - - 0 1");
+    auto queen_takes_pawn = board_state->build_move(d2, d5, 0);
+    CHECK_FALSE(board_state->see(queen_takes_pawn, 0));
+}
+
+TEST_CASE("Moves leave the accumulators alone while the network is off")
+{
+    REQUIRE_FALSE(NNUE::is_enabled());
+    auto board_state = board_from_fen(KIWIPETE_FEN);
+    MoveList move_list;
+    board_state->generate_moves(move_list);
+    for (auto index = 0; index < move_list.get_num_moves(); index++)
+    {
+        BoardstateCopy copy_of_state;
+        board_state->make_copy(copy_of_state);
+        auto move = move_list.get_move(index);
+        if (board_state->make_move(move, all_moves))
+        {
+            CHECK(board_state->get_accumulator_index() == 0);
+            CHECK(board_state->get_accumulators()[0].num_added == 0);
+            CHECK(board_state->get_accumulators()[0].num_removed == 0);
+        }
+        board_state->restore_copy(copy_of_state);
+    }
+}
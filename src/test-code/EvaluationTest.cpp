@@ -0,0 +1,42 @@
+#include "doctest.h"
+
+#include "../engine-code/Evaluation/PawnTable.h"
+#include "../engine-code/Evaluation/EvalCache.h"
+
+constexpr auto KEY = 0x0123456789ABCDEFull;
+
+TEST_CASE("Score tables return the newest score stored under a key")
+{
+    PawnTable::resize(PawnTable::DEFAULT_SIZE_MB);
+    PawnTable::reset_counters();
+    auto score = 0;
+    CHECK_FALSE(PawnTable::probe(KEY, score));
+    PawnTable::store(KEY, 35);
+    REQUIRE(PawnTable::probe(KEY, score));
+    CHECK(score == 35);
+    PawnTable::store(KEY, -20);
+    REQUIRE(PawnTable::probe(KEY, score));
+    CHECK(score == -20);
+    //A key in the same slot replaces the entry
+    PawnTable::store(KEY ^ (1ull << 63), 7);
+    CHECK_FALSE(PawnTable::probe(KEY, score));
+    CHECK(PawnTable::get_probes() == 4);
+    CHECK(PawnTable::get_hits() == 2);
+    PawnTable::clear();
+    CHECK_FALSE(PawnTable::probe(KEY ^ (1ull << 63), score));
+}
+
+TEST_CASE("Score tables round odd sizes down and keep their own entries")
+{
+    //3MB holds a power of two number of entries, so every key still has one slot
+    EvalCache::resize(3);
+    PawnTable::resize(PawnTable::DEFAULT_SIZE_MB);
+    EvalCache::clear();
+    PawnTable::clear();
+    EvalCache::store(KEY, 100);
+    auto score = 0;
+    CHECK_FALSE(PawnTable::probe(KEY, score));
+    REQUIRE(EvalCache::probe(KEY, score));
+    CHECK(score == 100);
+    EvalCache::resize(EvalCache::DEFAULT_SIZE_MB);
+}
@@ -0,0 +1,45 @@
+#include "doctest.h"
+
+#include "../engine-code/Search/TranspositionTable.h"
+
+constexpr auto STORED_KEYS = 1000ull;
+constexpr auto KEY_SHIFT = 32;
+constexpr auto GENERATIONS = 255;
+
+TEST_CASE("Stored entries are probed back with mate scores relative to the node")
+{
+    TranspositionTable::resize(3);
+    TranspositionTable::clear();
+    TranspositionTable::new_search();
+    auto key = 0x0123456789ABCDEFull;
+    auto move = PackedMove{};
+    TranspositionTable::store(key, 6, hash_flag_exact, 250, 0, move);
+    CHECK(TranspositionTable::probe(key, 6, -1000, 1000, 0, move) == 250);
+    CHECK(TranspositionTable::probe(key, 7, -1000, 1000, 0, move) == NO_HASH_ENTRY);
+    //Another key in the same slot does not hit
+    CHECK(TranspositionTable::probe(key ^ (1ull << 63), 6, -1000, 1000, 0, move) == NO_HASH_ENTRY);
+    //A mate found 3 plies below the node stored at ply 4 is read back at ply 2
+    TranspositionTable::store(key, 6, hash_flag_exact, HASH_MATE_BOUND + 100 - 4, 4, move);
+    CHECK(TranspositionTable::probe(key, 6, -1000, 1000, 2, move) == HASH_MATE_BOUND + 100 - 2);
+    //Bounds only cut off outside the window
+    TranspositionTable::store(key, 6, hash_flag_beta, 300, 0, move);
+    CHECK(TranspositionTable::probe(key, 6, -1000, 200, 0, move) == 200);
+    CHECK(TranspositionTable::probe(key, 6, -1000, 1000, 0, move) == NO_HASH_ENTRY);
+}
+
+TEST_CASE("Entries age out when the generation wraps")
+{
+    TranspositionTable::resize(1);
+    TranspositionTable::new_search();
+    for (auto key = 0ull; key < STORED_KEYS; key++)
+        TranspositionTable::store(((key + 1) << KEY_SHIFT) | key, 5, hash_flag_exact, 1, 0, PackedMove{});
+    CHECK(TranspositionTable::hashfull() == 1000);
+    //After a full cycle of the counter the entries must not look current again
+    for (auto generation = 0; generation < GENERATIONS; generation++)
+        TranspositionTable::new_search();
+    CHECK(TranspositionTable::hashfull() == 0);
+    for (auto generation = 0; generation < GENERATIONS + 1; generation++)
+        TranspositionTable::new_search();
+    CHECK(TranspositionTable::hashfull() == 0);
+    TranspositionTable::resize(TranspositionTable::DEFAULT_SIZE_MB);
+}
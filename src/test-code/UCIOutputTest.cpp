@@ -0,0 +1,40 @@
+#include "doctest.h"
+
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+
+#include "../GUI-code/UCI/UCIOutput.h"
+
+constexpr auto QUEUED_LINES = 2000;
+constexpr auto READY_OK = "readyok";
+
+TEST_CASE("flush writes every queued line before the caller prints")
+{
+    //Send stdout to a temporary file while the writer thread runs
+    fflush(stdout);
+    auto output = tmpfile();
+    REQUIRE(output != nullptr);
+    auto saved_stdout = dup(fileno(stdout));
+    dup2(fileno(output), fileno(stdout));
+    for (auto line = 0; line < QUEUED_LINES; line++)
+        UCIOutput::send("info line " + std::to_string(line));
+    UCIOutput::flush();
+    printf("%s\n", READY_OK);
+    fflush(stdout);
+    dup2(saved_stdout, fileno(stdout));
+    close(saved_stdout);
+
+    rewind(output);
+    char buffer[64];
+    auto num_lines = 0;
+    auto last_line = std::string{};
+    while (fgets(buffer, sizeof(buffer), output))
+    {
+        last_line = buffer;
+        num_lines++;
+    }
+    fclose(output);
+    CHECK(num_lines == QUEUED_LINES + 1);
+    CHECK(last_line == std::string(READY_OK) + "\n");
+}
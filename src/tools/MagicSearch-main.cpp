@@ -0,0 +1,294 @@
+//Standalone magic number search for the OmegaChess Engine
+//
+//Searches the rook and bishop magics of all 128 squares in parallel, verifies them and
+//writes engine-code/MagicNumbers.h. By default the magics already in MagicNumbers.h are
+//kept and only checked, "shrink N" then tries to find magics with up to N fewer index
+//bits per square so the attack tables get smaller.
+//
+//Build from src:  g++ -std=c++17 -O2 -pthread tools/MagicSearch-main.cpp -o magic-search
+//Usage:           magic-search [threads N] [shrink N] [attempts N] [seed N] [fresh] [out FILE]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../engine-code/BitBoard.h"
+#include "../engine-code/Pieces/Bishop.h"
+#include "../engine-code/Pieces/Rook.h"
+#include "../engine-code/MagicNumbers.h"
+
+constexpr auto NUM_SQUARES = 64;
+constexpr auto SQUARES_IN_ROW = 8;
+constexpr auto NUM_SLIDERS = 2;
+constexpr auto NUM_JOBS = NUM_SQUARES * NUM_SLIDERS;
+constexpr auto DEFAULT_ATTEMPTS = 100000000ll;
+constexpr auto DEFAULT_SEED = 1804289383ull;
+constexpr auto DEFAULT_OUTPUT = "engine-code/MagicNumbers.h";
+//Candidates spreading the mask into fewer upper bits than this rarely work
+constexpr auto MINIMUM_BITS_FOR_MAGIC = 6;
+constexpr auto FINAL_8_BITS = 0xFF00000000000000ull;
+constexpr auto GOLDEN_RATIO_64 = 0x9E3779B97F4A7C15ull;
+
+//xorshift64*, one generator per job so the result does not depend on the thread count
+class MagicRandom
+{
+public:
+    explicit MagicRandom(unsigned long long seed): state_{seed ? seed : GOLDEN_RATIO_64} {}
+    unsigned long long next()
+    {
+        state_ ^= state_ >> 12;
+        state_ ^= state_ << 25;
+        state_ ^= state_ >> 27;
+        return state_ * 0x2545F4914F6CDD1Dull;
+    }
+    //Magics with few set bits are far more likely to work
+    unsigned long long sparse()
+    {
+        return next() & next() & next();
+    }
+private:
+    unsigned long long state_;
+};
+
+//Every subset of one square's blocker mask with the attacks it allows
+class SquareOccupancies
+{
+public:
+    SquareOccupancies(int piece_type, int square):
+        mask{(piece_type == rook) ? RookAttacks::mask_rook_occupancies(square) :
+                                    BishopAttacks::mask_bishop_occupancies(square)}
+    {
+        auto occupancy = bitboard{};
+        do
+        {
+            occupancies.push_back(occupancy);
+            attacks.push_back((piece_type == rook) ? RookAttacks::gen_rook_attacks_on_the_fly(square, occupancy) :
+                                                     BishopAttacks::gen_bishop_attacks_on_the_fly(square, occupancy));
+            occupancy = (occupancy - mask) & mask;
+        } while (occupancy);
+    }
+    bitboard mask;
+    std::vector<bitboard> occupancies;
+    std::vector<bitboard> attacks;
+};
+
+//Returns true if no two occupancies with different attacks share an index. Occupancies
+//with the same attacks may share one, that is what lets a magic use fewer bits than the
+//mask has. The stamps save clearing the table for every candidate.
+static bool magic_works(const SquareOccupancies &square_occupancies, bitboard magic, int bits,
+                        std::vector<bitboard> &used, std::vector<unsigned int> &stamps, unsigned int stamp)
+{
+    for (size_t index = 0; index < square_occupancies.occupancies.size(); index++)
+    {
+        auto magic_index = static_cast<size_t>((square_occupancies.occupancies[index] * magic) >> (NUM_SQUARES - bits));
+        if (stamps[magic_index] != stamp)
+        {
+            stamps[magic_index] = stamp;
+            used[magic_index] = square_occupancies.attacks[index];
+        }
+        else if (used[magic_index] != square_occupancies.attacks[index])
+            return false;
+    }
+    return true;
+}
+
+class MagicResult
+{
+public:
+    bitboard magic = 0;
+    int bits = 0;
+};
+
+class SearchOptions
+{
+public:
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+    int shrink = 0;
+    long long attempts = DEFAULT_ATTEMPTS;
+    unsigned long long seed = DEFAULT_SEED;
+    bool fresh = false;
+    std::string output = DEFAULT_OUTPUT;
+};
+
+//Finds a magic for one square with the given number of index bits, or a zero magic
+static bitboard search_magic(const SquareOccupancies &square_occupancies, int bits, long long attempts,
+                             MagicRandom &random)
+{
+    auto used = std::vector<bitboard>(1ull << bits);
+    auto stamps = std::vector<unsigned int>(1ull << bits);
+    for (auto attempt = 1ll; attempt <= attempts; attempt++)
+    {
+        auto magic = random.sparse();
+        if (Bitboard::count_bits((square_occupancies.mask * magic) & FINAL_8_BITS) < MINIMUM_BITS_FOR_MAGIC)
+            continue;
+        if (magic_works(square_occupancies, magic, bits, used, stamps, static_cast<unsigned int>(attempt)))
+            return magic;
+    }
+    return bitboard{};
+}
+
+static MagicResult find_magic(int job, const SearchOptions &options)
+{
+    auto piece_type = (job < NUM_SQUARES) ? rook : bishop;
+    auto square = job % NUM_SQUARES;
+    auto square_occupancies = SquareOccupancies{piece_type, square};
+    auto random = MagicRandom{options.seed ^ (GOLDEN_RATIO_64 * (job + 1))};
+    auto result = MagicResult{};
+    //Start from the magic already in use unless asked not to
+    if (!options.fresh)
+    {
+        result.magic = (piece_type == rook) ? Magic::rook_magic_numbers[square] : Magic::bishop_magic_numbers[square];
+        result.bits = (piece_type == rook) ? Magic::rook_index_bits[square] : Magic::bishop_index_bits[square];
+        auto used = std::vector<bitboard>(1ull << result.bits);
+        auto stamps = std::vector<unsigned int>(1ull << result.bits);
+        if (!magic_works(square_occupancies, result.magic, result.bits, used, stamps, 1))
+            result = MagicResult{};
+    }
+    if (!result.magic)
+    {
+        result.bits = Bitboard::count_bits(square_occupancies.mask);
+        result.magic = search_magic(square_occupancies, result.bits, options.attempts, random);
+        if (!result.magic)
+            return MagicResult{};
+    }
+    auto fewest_bits = std::max(1, result.bits - options.shrink);
+    for (auto bits = result.bits - 1; bits >= fewest_bits; bits--)
+    {
+        auto magic = search_magic(square_occupancies, bits, options.attempts, random);
+        if (!magic)
+            break;
+        result.magic = magic;
+        result.bits = bits;
+    }
+    return result;
+}
+
+//Checks every occupancy of every square once more against the finished magics
+static bool verify_magics(const std::vector<MagicResult> &results)
+{
+    for (auto job = 0; job < NUM_JOBS; job++)
+    {
+        auto square_occupancies = SquareOccupancies{(job < NUM_SQUARES) ? rook : bishop, job % NUM_SQUARES};
+        auto used = std::vector<bitboard>(1ull << results[job].bits);
+        auto stamps = std::vector<unsigned int>(1ull << results[job].bits);
+        if (!results[job].magic ||
+            !magic_works(square_occupancies, results[job].magic, results[job].bits, used, stamps, 1))
+        {
+            printf("magic for %s on square %d does not work\n", (job < NUM_SQUARES) ? "rook" : "bishop",
+                   job % NUM_SQUARES);
+            return false;
+        }
+    }
+    return true;
+}
+
+static void write_magic_array(FILE *file, const char *name, const std::vector<MagicResult> &results, int first)
+{
+    fprintf(file, "    inline constexpr bitboard %s_magic_numbers[TOTAL_SQUARES] = {\n", name);
+    for (auto square = 0; square < NUM_SQUARES; square++)
+        fprintf(file, "         0x%llxULL,\n", results[first + square].magic);
+    fprintf(file, "    };\n\n");
+}
+
+static void write_bits_array(FILE *file, const char *name, const std::vector<MagicResult> &results, int first)
+{
+    fprintf(file, "    inline constexpr int %s_index_bits[TOTAL_SQUARES] = {\n", name);
+    for (auto rank = 0; rank < NUM_SQUARES / SQUARES_IN_ROW; rank++)
+    {
+        fprintf(file, "       ");
+        for (auto file_index = 0; file_index < SQUARES_IN_ROW; file_index++)
+            fprintf(file, " %d,", results[first + rank * SQUARES_IN_ROW + file_index].bits);
+        fprintf(file, "\n");
+    }
+    fprintf(file, "    };\n\n");
+}
+
+static bool write_header(const std::string &file_name, const std::vector<MagicResult> &results)
+{
+    auto file = fopen(file_name.c_str(), "w");
+    if (!file)
+        return false;
+    fprintf(file, "#ifndef MAGICNUMBERS_H\n#define MAGICNUMBERS_H\n\n");
+    fprintf(file, "#include \"BitBoard.h\"\n\n");
+    fprintf(file, "/** \\file MagicNumbers.h\n    \\brief Contains the generated magic numbers\n */\n\n");
+    fprintf(file, "//Written by tools/MagicSearch-main.cpp, do not edit by hand.\n");
+    fprintf(file, "//The attack table index of a square is (occupancy * magic) >> (64 - index bits).\n");
+    fprintf(file, "namespace Magic\n{\n");
+    fprintf(file, "    constexpr auto TOTAL_SQUARES = 64;\n\n");
+    write_magic_array(file, "rook", results, 0);
+    write_bits_array(file, "rook", results, 0);
+    write_magic_array(file, "bishop", results, NUM_SQUARES);
+    write_bits_array(file, "bishop", results, NUM_SQUARES);
+    fprintf(file, "}\n\n#endif\n");
+    return fclose(file) == 0;
+}
+
+static SearchOptions parse_options(int argc, char *argv[])
+{
+    auto options = SearchOptions{};
+    for (auto arg = 1; arg < argc; arg++)
+    {
+        auto has_value = arg + 1 < argc;
+        if (!strcmp(argv[arg], "threads") && has_value)
+            options.threads = std::max(1, atoi(argv[++arg]));
+        else if (!strcmp(argv[arg], "shrink") && has_value)
+            options.shrink = std::max(0, atoi(argv[++arg]));
+        else if (!strcmp(argv[arg], "attempts") && has_value)
+            options.attempts = std::max(1ll, atoll(argv[++arg]));
+        else if (!strcmp(argv[arg], "seed") && has_value)
+            options.seed = strtoull(argv[++arg], nullptr, 10);
+        else if (!strcmp(argv[arg], "out") && has_value)
+            options.output = argv[++arg];
+        else if (!strcmp(argv[arg], "fresh"))
+            options.fresh = true;
+        else
+            printf("ignoring unknown option %s\n", argv[arg]);
+    }
+    return options;
+}
+
+static long long table_entries(const std::vector<MagicResult> &results, int first)
+{
+    auto entries = 0ll;
+    for (auto square = 0; square < NUM_SQUARES; square++)
+        entries += 1ll << results[first + square].bits;
+    return entries;
+}
+
+int main(int argc, char *argv[])
+{
+    auto options = parse_options(argc, argv);
+    auto start_time = std::chrono::steady_clock::now();
+    auto results = std::vector<MagicResult>(NUM_JOBS);
+    //Rook squares come first and take by far the longest, threads take the next job as they finish
+    auto next_job = std::atomic<int>{0};
+    auto workers = std::vector<std::thread>{};
+    for (auto thread = 0; thread < options.threads; thread++)
+    {
+        workers.emplace_back([&]()
+        {
+            for (auto job = next_job++; job < NUM_JOBS; job = next_job++)
+                results[job] = find_magic(job, options);
+        });
+    }
+    for (auto &worker : workers)
+        worker.join();
+    if (!verify_magics(results))
+        return EXIT_FAILURE;
+    auto time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time);
+    printf("rook entries %lld bishop entries %lld time %lldms\n", table_entries(results, 0),
+           table_entries(results, NUM_SQUARES), static_cast<long long>(time.count()));
+    if (!write_header(options.output, results))
+    {
+        printf("could not write %s\n", options.output.c_str());
+        return EXIT_FAILURE;
+    }
+    printf("wrote %s\n", options.output.c_str());
+    return EXIT_SUCCESS;
+}